@@ -0,0 +1,430 @@
+/**
+ * @file Bench_Classes.cpp
+ * @brief Benchmark positions, cases and runner.
+ *
+ * This file replaces the global operator new so that allocations can be
+ * counted; it is only linked into the bench executable.
+ */
+
+#include "Bench_Classes.h"
+#include "SelfPlay_Classes.h"
+#include "NUMTTT_classes.h"
+#include "XO_Classes.h"
+#include "FourInRow_Classes.h"
+#include "Misere_Classes.h"
+#include "FiveXFiveTTT_Classes.h"
+#include "Infinity_Tic-Tac-Toe.h"
+#include "SUS_Classes.h"
+#include "Pyramid_Classes.h"
+#include "word_Tic-Tac-Toe.h"
+#include "DiamondTTT_Classes.h"
+#include "ultimateTTT_Classes.h"
+#include "Memory_Classes.h"
+#include "Obstacles_Tic-Tac-Toe.h"
+#include "FourByFour_Classes.h"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <memory>
+#include <new>
+#include <random>
+
+using namespace std;
+
+// -----------------------------------------------------------------------------
+// Allocation counting
+// -----------------------------------------------------------------------------
+
+namespace {
+atomic<long long> allocations{0}; ///< Calls to operator new since start-up.
+
+/**
+ * @brief Counts and makes one allocation, over-aligned if `align` exceeds
+ * what malloc guarantees. This and release() stay out of line so the
+ * compiler never sees malloc and free at the call sites of new and delete.
+ */
+[[gnu::noinline]] void* allocate(size_t size, size_t align) {
+    allocations.fetch_add(1, memory_order_relaxed);
+    if (size == 0) size = 1;
+    void* p = align <= alignof(max_align_t) ? malloc(size)
+                                            : aligned_alloc(align, (size + align - 1) / align * align);
+    if (p) return p;
+    throw bad_alloc();
+}
+
+/** @brief Frees memory from allocate(). */
+[[gnu::noinline]] void release(void* p) noexcept { free(p); }
+}
+
+// The array and nothrow forms forward to these in the standard library
+void* operator new(size_t size) { return allocate(size, 0); }
+void* operator new(size_t size, align_val_t align) { return allocate(size, (size_t)align); }
+
+void operator delete(void* p) noexcept { release(p); }
+void operator delete(void* p, size_t) noexcept { release(p); }
+void operator delete(void* p, align_val_t) noexcept { release(p); }
+void operator delete(void* p, size_t, align_val_t) noexcept { release(p); }
+
+namespace {
+
+// -----------------------------------------------------------------------------
+// Positions
+// -----------------------------------------------------------------------------
+
+/** @brief Seed of the random play leading to each position (and of the Obstacles board). */
+const unsigned BENCH_SEED = 20240601;
+
+/** @brief Keeps results the compiler could otherwise discard. */
+volatile long long sink = 0;
+
+/**
+ * @brief A fixed position: the moves leading to it from a new board, and
+ * one legal move for the side to move there.
+ */
+template <typename T>
+struct Opening {
+    function<Board<T>*()> make; ///< Allocates a board in its starting state.
+    T symbols[2];               ///< First and second player's symbols.
+    vector<Move<T>> moves;      ///< Moves played from the start.
+    Move<T> next;               ///< Legal move for the side to move.
+
+    T to_move() const { return symbols[moves.size() % 2]; }
+    T last_mover() const { return symbols[(moves.size() + 1) % 2]; }
+
+    /** @brief Builds a new board in this position. */
+    Board<T>* build() const {
+        Board<T>* board = make();
+        for (Move<T> m : moves) board->update_board(&m);
+        return board;
+    }
+};
+
+/**
+ * @brief True if no move of the side to move ends the game, so searches
+ * from here have to look past the first ply.
+ */
+template <typename T>
+bool is_quiet(const Opening<T>& opening, const MoveList<T>& moves) {
+    Player<T> mover("bench", opening.to_move(), PlayerType::COMPUTER);
+    for (Move<T> m : moves) {
+        unique_ptr<Board<T>> board(opening.build());
+        board->update_board(&m);
+        if (board->get_outcome(&mover) != Outcome::ONGOING) return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Plays `plies` random moves from the start, trying again from the
+ * start until the game has not ended on the way and the position reached
+ * is quiet.
+ */
+template <typename T>
+Opening<T> make_opening(function<Board<T>*()> make, T sym_x, T sym_o, int plies, unsigned seed = BENCH_SEED) {
+    Opening<T> opening{make, {sym_x, sym_o}, {}, Move<T>(0, 0, sym_x)};
+    minstd_rand rng(seed);
+    Player<T> players[2] = {Player<T>("X", sym_x, PlayerType::COMPUTER),
+                            Player<T>("O", sym_o, PlayerType::COMPUTER)};
+    MoveList<T> moves;
+
+    while (true) {
+        unique_ptr<Board<T>> board(make());
+        opening.moves.clear();
+        bool ended = false;
+
+        for (int k = 0; k < plies && !ended; ++k) {
+            if (board->generate_moves(opening.symbols[k % 2], moves) == 0) break;
+            Move<T> m = moves[rng() % moves.size()];
+            board->update_board(&m);
+            opening.moves.push_back(m);
+            ended = board->get_outcome(&players[k % 2]) != Outcome::ONGOING;
+        }
+        if (ended || board->generate_moves(opening.to_move(), moves) == 0 || !is_quiet(opening, moves)) continue;
+        opening.next = moves[rng() % moves.size()];
+        return opening;
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Cases
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief Adds the cases every board supports: update_board, is_win,
+ * is_draw and generate_moves.
+ */
+template <typename T>
+void add_board_cases(vector<BenchCase>& cases, int game, const Opening<T>& opening) {
+    auto boards = make_shared<vector<unique_ptr<Board<T>>>>();
+    auto player = make_shared<Player<T>>("bench", opening.last_mover(), PlayerType::COMPUTER);
+    auto moves = make_shared<MoveList<T>>();
+
+    // One fresh board per call, since each call changes it
+    auto prepare_many = [boards, opening](int n) {
+        boards->clear();
+        for (int i = 0; i < n; ++i) boards->emplace_back(opening.build());
+    };
+    // Read-only operations share a single board
+    auto prepare_one = [boards, opening](int) {
+        boards->clear();
+        boards->emplace_back(opening.build());
+    };
+
+    cases.push_back({game, "update_board", prepare_many, [boards, opening](int i) {
+        Move<T> m = opening.next;
+        sink += (*boards)[i]->update_board(&m);
+        return 0LL;
+    }});
+    cases.push_back({game, "is_win", prepare_one, [boards, player](int) {
+        sink += (*boards)[0]->is_win(player.get());
+        return 0LL;
+    }});
+    cases.push_back({game, "is_draw", prepare_one, [boards, player](int) {
+        sink += (*boards)[0]->is_draw(player.get());
+        return 0LL;
+    }});
+    cases.push_back({game, "generate_moves", prepare_one, [boards, moves, opening](int) {
+        sink += (*boards)[0]->generate_moves(opening.to_move(), *moves);
+        return 0LL;
+    }});
+}
+
+/**
+ * @brief Adds a case timing a computer player on a fresh board per call.
+ * @param think Runs the player on the board; returns the positions it searched.
+ */
+template <typename B>
+void add_ai_case(vector<BenchCase>& cases, int game, const string& op,
+                 const Opening<char>& opening, function<long long(B*, char)> think) {
+    auto boards = make_shared<vector<unique_ptr<B>>>();
+    char side = opening.to_move();
+
+    cases.push_back({game, op,
+        [boards, opening](int n) {
+            boards->clear();
+            for (int i = 0; i < n; ++i) boards->emplace_back(static_cast<B*>(opening.build()));
+        },
+        [boards, think, side](int i) { return think((*boards)[i].get(), side); }});
+}
+
+/**
+ * @brief Adds a case running a computer player on every position of a set;
+ * one operation covers the whole set, so nodes per operation compare
+ * search effort between versions.
+ */
+template <typename B>
+void add_ai_set_case(vector<BenchCase>& cases, int game, const string& op,
+                     const vector<Opening<char>>& openings, function<long long(B*, char)> think) {
+    auto boards = make_shared<vector<unique_ptr<B>>>();
+    size_t k = openings.size();
+
+    cases.push_back({game, op,
+        [boards, openings](int n) {
+            boards->clear();
+            for (int i = 0; i < n; ++i)
+                for (const Opening<char>& o : openings) boards->emplace_back(static_cast<B*>(o.build()));
+        },
+        [boards, think, openings, k](int i) {
+            long long nodes = 0;
+            for (size_t j = 0; j < k; ++j) nodes += think((*boards)[i * k + j].get(), openings[j].to_move());
+            return nodes;
+        }});
+}
+
+/** @brief The other player's symbol in the X/O games. */
+char other(char side) { return side == 'X' ? 'O' : 'X'; }
+
+vector<BenchCase> build_cases() {
+    vector<BenchCase> cases;
+
+    Opening<int> numerical = make_opening<int>([] { return new NumTTT_Board(); }, 1, 2, 2);
+    add_board_cases(cases, 0, numerical);
+
+    Opening<char> xo = make_opening<char>([] { return new X_O_Board(); }, 'X', 'O', 2);
+    add_board_cases(cases, 1, xo);
+    add_ai_case<X_O_Board>(cases, 1, "get_best_move", xo, [](X_O_Board* b, char side) {
+        Move<char> best(0, 0, side);
+        b->get_best_move(side, best);
+        sink += best.get_x();
+        return 0LL;
+    });
+
+    Opening<char> four = make_opening<char>([] { return new FourInRow_Board(); }, 'X', 'O', 8);
+    add_board_cases(cases, 2, four);
+    add_ai_case<FourInRow_Board>(cases, 2, "get_best_move", four, [](FourInRow_Board* b, char side) {
+        SearchLimits limits;
+        limits.max_nodes = 1000000; // Fixed work; a time budget would just measure itself
+        b->set_search_limits(limits);
+        b->set_opening_book(nullptr); // Time the search even if a book is present
+        sink += b->get_best_move(side);
+        return b->get_search_nodes();
+    });
+    // Fixed depth over eight positions (6 to 20 plies in): nodes per op track move ordering
+    vector<Opening<char>> four_set;
+    for (unsigned k = 0; k < 8; ++k)
+        four_set.push_back(make_opening<char>([] { return new FourInRow_Board(); }, 'X', 'O', 6 + 2 * k, BENCH_SEED + k));
+    add_ai_set_case<FourInRow_Board>(cases, 2, "search_depth_10", four_set, [](FourInRow_Board* b, char side) {
+        SearchLimits limits;
+        limits.max_depth = 10;
+        limits.max_seconds = 0;
+        b->set_search_limits(limits);
+        b->set_opening_book(nullptr);
+        sink += b->get_best_move(side);
+        return b->get_search_nodes();
+    });
+    // The bigger compiled boards, and the run-time sized board on the classic shape
+    struct Shape { int rows, columns, connect; bool dynamic; };
+    for (Shape s : {Shape{7, 8, 4, false}, Shape{8, 9, 4, false}, Shape{8, 9, 5, false}, Shape{6, 7, 4, true}}) {
+        function<Board<char>*()> make = [s]() -> Board<char>* {
+            if (s.dynamic) return new ConnectN_DynamicBoard(s.rows, s.columns, s.connect);
+            return make_connect_board(s.rows, s.columns, s.connect);
+        };
+        string name = to_string(s.rows) + "x" + to_string(s.columns) + "_connect" + to_string(s.connect);
+        if (s.dynamic) name = "dynamic_" + name;
+        add_ai_case<ConnectN_BoardBase>(cases, 2, "get_best_move_" + name, make_opening<char>(make, 'X', 'O', 8),
+                                        [](ConnectN_BoardBase* b, char side) {
+            SearchLimits limits;
+            limits.max_nodes = 200000;
+            b->set_search_limits(limits);
+            sink += b->get_best_move(side);
+            return b->get_search_nodes();
+        });
+    }
+
+    Opening<char> fxf = make_opening<char>([] { return new FxFTTT_board(); }, 'X', 'O', 6);
+    add_board_cases(cases, 3, fxf);
+    add_ai_case<FxFTTT_board>(cases, 3, "find_best_move", fxf, [](FxFTTT_board* b, char side) {
+        b->set_ai_symbols(side, other(side));
+        b->set_database(nullptr);
+        sink += b->find_best_move().first;
+        return b->get_search_nodes();
+    });
+
+    Opening<char> word = make_opening<char>([] { return new word_xo_board(); }, 'X', 'O', 2);
+    add_board_cases(cases, 4, word);
+    add_ai_case<word_xo_board>(cases, 4, "find_best_move", word, [](word_xo_board* b, char) {
+        sink += b->find_best_move().get_x();
+        return 0LL;
+    });
+
+    Opening<char> misere = make_opening<char>([] { return new Misere_Board(); }, 'X', 'O', 2);
+    add_board_cases(cases, 5, misere);
+    add_ai_case<Misere_Board>(cases, 5, "get_smart_move", misere, [](Misere_Board* b, char side) {
+        Misere_AIPlayer ai("bench", side);
+        sink += ai.get_smart_move(b, other(side)).get_x();
+        return 0LL;
+    });
+    // 4 in a row on 4x4 and 5x5, searched to a fixed node budget
+    for (int size = 4; size <= 5; ++size) {
+        Opening<char> larger = make_opening<char>([size] { return new Misere_Board(size, 4); }, 'X', 'O', 4);
+        add_ai_case<Misere_Board>(cases, 5, "choose_move_" + to_string(size) + "x" + to_string(size), larger,
+                                  [](Misere_Board* b, char side) {
+            Misere_AIPlayer ai("bench", side);
+            SearchLimits limits;
+            limits.max_nodes = 100000;
+            ai.set_search_limits(limits);
+            sink += ai.choose_move(b, other(side)).get_x();
+            return ai.get_search_nodes();
+        });
+    }
+
+    Opening<char> sus = make_opening<char>([] {
+        SUS_Board* board = new SUS_Board();
+        board->set_player_letters('S', 'U');
+        return board;
+    }, 'S', 'U', 2);
+    add_board_cases(cases, 6, sus);
+    add_ai_case<SUS_Board>(cases, 6, "get_best_move", sus, [](SUS_Board* b, char side) {
+        sink += b->get_best_move(side).first;
+        return 0LL;
+    });
+
+    Opening<char> pyramid = make_opening<char>([] { return new Pyramid_Board(); }, 'X', 'O', 2);
+    add_board_cases(cases, 7, pyramid);
+    add_ai_case<Pyramid_Board>(cases, 7, "get_best_move", pyramid, [](Pyramid_Board* b, char side) {
+        sink += b->get_best_move(side).first;
+        return b->get_search_nodes();
+    });
+
+    Opening<char> infinity = make_opening<char>([] { return new inf_xo_Board(); }, 'X', 'O', 4);
+    add_board_cases(cases, 8, infinity);
+
+    Opening<char> diamond = make_opening<char>([] { return new Diamond_Board(); }, 'X', 'O', 2);
+    add_board_cases(cases, 9, diamond);
+    add_ai_case<Diamond_Board>(cases, 9, "get_smart_move", diamond, [](Diamond_Board* b, char side) {
+        Diamond_AIPlayer ai("bench", side);
+        sink += ai.get_smart_move(b, other(side)).get_x();
+        return ai.get_search_nodes();
+    });
+
+    Opening<char> ultimate = make_opening<char>([] { return new Ultimate_Board(); }, 'X', 'O', 10);
+    add_board_cases(cases, 10, ultimate);
+
+    Opening<char> memory = make_opening<char>([] { return new Memory_Board(); }, 'X', 'O', 2);
+    add_board_cases(cases, 11, memory);
+
+    Opening<char> obstacles = make_opening<char>([] { return new obstacles_TTT_board(BENCH_SEED); }, 'X', 'O', 2);
+    add_board_cases(cases, 12, obstacles);
+
+    Opening<char> slide = make_opening<char>([] { return new FourByFour_Board(); }, 'X', 'O', 4);
+    add_board_cases(cases, 13, slide);
+    add_ai_case<FourByFour_Board>(cases, 13, "find_best_move", slide, [](FourByFour_Board* b, char side) {
+        sink += b->find_best_move(side, 6).get_x();
+        return b->get_search_nodes();
+    });
+
+    return cases;
+}
+
+/** @brief Largest number of inputs built at once; longer runs use several batches. */
+const int MAX_BATCH = 4096;
+
+} // namespace
+
+// -----------------------------------------------------------------------------
+// Runner
+// -----------------------------------------------------------------------------
+
+const vector<BenchCase>& bench_cases() {
+    static const vector<BenchCase> cases = build_cases();
+    return cases;
+}
+
+BenchResult run_bench(const BenchCase& c, double min_seconds) {
+    BenchResult result;
+    result.game = c.game;
+    result.op = c.op;
+
+    ScopedSilence quiet;
+    c.prepare(1);
+    c.run(0);
+
+    long long total_ns = 0, nodes = 0, allocs = 0;
+    for (int n = 1; total_ns < min_seconds * 1e9; n = min(2 * n, MAX_BATCH)) {
+        c.prepare(n);
+        long long allocs_before = allocations.load(memory_order_relaxed);
+        auto start = chrono::steady_clock::now();
+        for (int i = 0; i < n; ++i) nodes += c.run(i);
+        total_ns += chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count();
+        allocs += allocations.load(memory_order_relaxed) - allocs_before;
+        result.ops += n;
+    }
+    c.prepare(0);
+
+    result.ns_per_op = (double)total_ns / result.ops;
+    result.nodes_per_sec = total_ns > 0 ? nodes * 1e9 / total_ns : 0;
+    result.nodes_per_op = (double)nodes / result.ops;
+    result.allocs_per_op = (double)allocs / result.ops;
+    return result;
+}
+
+void print_bench_csv(ostream& out, const vector<BenchResult>& results) {
+    const vector<SelfPlayGame>& catalog = self_play_games();
+    out << "game,op,ops,ns_per_op,nodes_per_sec,allocs_per_op,nodes_per_op\n";
+    for (const BenchResult& r : results) {
+        out << '"' << catalog[r.game].name << "\"," << r.op << ',' << r.ops << ','
+            << fixed << setprecision(1) << r.ns_per_op << ',' << setprecision(0) << r.nodes_per_sec << ','
+            << setprecision(3) << r.allocs_per_op << ',' << setprecision(0) << r.nodes_per_op << "\n";
+    }
+}
@@ -0,0 +1,75 @@
+/**
+ * @file Bench_Classes.h
+ * @brief Micro-benchmarks of every board's hot operations.
+ *
+ * Each game is set up in a fixed position, reached by seeded random play
+ * from the start. update_board, the win/draw checks, move generation and
+ * the computer player's entry point are then timed on that position. The
+ * results are meant to be diffed between releases by a script, so they
+ * are printed one CSV line per case.
+ */
+
+#ifndef BENCH_CLASSES_H
+#define BENCH_CLASSES_H
+
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/**
+ * @struct BenchCase
+ * @brief One timed operation on one game.
+ *
+ * Every input is used by exactly one call of `run`, so operations that
+ * change the board (update_board, the AI searches) always start from the
+ * same position.
+ */
+struct BenchCase {
+    int game;   ///< Catalog index (0-based, main-menu order).
+    string op;  ///< Name of the operation timed.
+
+    /** @brief Builds inputs 0 .. n-1. Not timed. */
+    function<void(int n)> prepare;
+
+    /** @brief Runs the operation once on input `i`. Returns the positions searched (0 if none). */
+    function<long long(int i)> run;
+};
+
+/**
+ * @struct BenchResult
+ * @brief Measurements of one case.
+ */
+struct BenchResult {
+    int game = 0;
+    string op;
+    long long ops = 0;          ///< Operations timed.
+    double ns_per_op = 0;
+    double nodes_per_sec = 0;   ///< 0 for operations that do not search.
+    double allocs_per_op = 0;   ///< Calls to operator new per operation.
+    double nodes_per_op = 0;    ///< Positions searched per operation (0 if none).
+};
+
+/**
+ * @brief Returns every case, games in main-menu order.
+ */
+const vector<BenchCase>& bench_cases();
+
+/**
+ * @brief Runs `c` in batches of growing size until the batches add up to
+ * at least `min_seconds` of timed work.
+ *
+ * One untimed call warms the caches (and any lazily allocated tables of
+ * code shared between inputs) first. Console output of the boards is
+ * discarded while the case runs.
+ */
+BenchResult run_bench(const BenchCase& c, double min_seconds);
+
+/**
+ * @brief Prints results as CSV: a header line, then one line per case.
+ */
+void print_bench_csv(ostream& out, const vector<BenchResult>& results);
+
+#endif // BENCH_CLASSES_H
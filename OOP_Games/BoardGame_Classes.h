@@ -11,6 +11,11 @@
 #include <vector>
 #include <iostream>
 #include <iomanip>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <utility>
 using namespace std;
 
 /////////////////////////////////////////////////////////////
@@ -19,6 +24,7 @@ using namespace std;
 
 template <typename T> class Player;
 template <typename T> class Move;
+template <typename T> class MoveList;
 
 /////////////////////////////////////////////////////////////
 // Class declarations
@@ -34,12 +40,147 @@ enum class PlayerType {
     RANDOM     ///< A Random player.
 };
 
+/**
+ * @brief State of the game after a move, seen by the player who made it.
+ */
+enum class Outcome {
+    ONGOING, ///< Nobody has won yet and moves remain.
+    WIN,     ///< The player who moved has won.
+    LOSE,    ///< The player who moved has lost.
+    DRAW     ///< The game ended without a winner.
+};
+
+/**
+ * @brief Row-major contiguous storage for the cells of a board.
+ *
+ * @tparam T Type of the elements stored on the board.
+ *
+ * All cells live in one flat buffer indexed as `r * columns + c`, so reading
+ * a cell is a single multiply-add instead of a pointer chase through a row
+ * vector. Boards with up to INLINE_CELLS cells (every board in this project,
+ * the largest being the 9x9 Ultimate board) keep the buffer inside the object
+ * itself and never touch the heap; larger boards fall back to one allocation.
+ */
+template <typename T>
+class BoardCells {
+public:
+    static const int INLINE_CELLS = 81; ///< Cells stored inline without allocation.
+
+private:
+    int columns;            ///< Row stride of the buffer
+    int n_cells;            ///< Total number of cells (rows * columns)
+    T inline_cells[INLINE_CELLS]; ///< Inline buffer for small boards
+    vector<T> heap_cells;   ///< Fallback buffer for large boards
+    T* cells;               ///< Points at whichever buffer is in use
+
+    void bind() {
+        if (n_cells <= INLINE_CELLS) cells = inline_cells;
+        else {
+            heap_cells.resize(n_cells);
+            cells = heap_cells.data();
+        }
+    }
+
+public:
+    /** @brief Create storage for a rows x columns board. */
+    BoardCells(int rows, int columns)
+        : columns(columns), n_cells(rows * columns), inline_cells() {
+        bind();
+    }
+
+    /** @brief Copy the cells of another board (keeps the inline buffer local). */
+    BoardCells(const BoardCells& other)
+        : columns(other.columns), n_cells(other.n_cells) {
+        bind();
+        for (int i = 0; i < n_cells; ++i) cells[i] = other.cells[i];
+    }
+
+    BoardCells& operator=(const BoardCells& other) {
+        if (this != &other) {
+            columns = other.columns;
+            n_cells = other.n_cells;
+            bind();
+            for (int i = 0; i < n_cells; ++i) cells[i] = other.cells[i];
+        }
+        return *this;
+    }
+
+    /** @brief Access cell (r, c). No bounds checking. */
+    T& at(int r, int c) { return cells[r * columns + c]; }
+    const T& at(int r, int c) const { return cells[r * columns + c]; }
+
+    /** @brief Set every cell to the given value. */
+    void fill(const T& value) {
+        for (int i = 0; i < n_cells; ++i) cells[i] = value;
+    }
+
+    /** @brief Number of cells in the buffer. */
+    int size() const { return n_cells; }
+
+    /** @brief Pointer to the first cell (row-major order). */
+    T* data() { return cells; }
+    const T* data() const { return cells; }
+
+    T* begin() { return cells; }
+    T* end() { return cells + n_cells; }
+    const T* begin() const { return cells; }
+    const T* end() const { return cells + n_cells; }
+};
+
+//-----------------------------------------------------
+/**
+ * @brief Non-owning, read-only view of a board's cells.
+ *
+ * @tparam T Type of the elements stored on the board.
+ *
+ * A view is a pointer to the board's cell buffer plus its dimensions, so
+ * taking one costs nothing and reading through it never copies the board.
+ * A board that must not reveal its real contents (e.g. Memory Tic-Tac-Toe)
+ * can attach a mask function that is applied lazily to each cell as it is read.
+ * The view is only valid while the board it came from is alive.
+ */
+template <typename T>
+class BoardView {
+public:
+    /** @brief Maps the stored value of cell (r, c) to the value shown. */
+    typedef T (*Mask)(const void* owner, int r, int c, const T& value);
+
+private:
+    const T* cells;      ///< First cell of the row-major buffer
+    int rows;            ///< Number of rows
+    int columns;         ///< Number of columns
+    Mask mask;           ///< Optional per-cell mask (nullptr = show as stored)
+    const void* owner;   ///< Context handed to the mask
+
+public:
+    /** @brief Construct a view over a row-major buffer. */
+    BoardView(const T* cells, int rows, int columns,
+              Mask mask = nullptr, const void* owner = nullptr)
+        : cells(cells), rows(rows), columns(columns), mask(mask), owner(owner) {}
+
+    /** @brief Return the (possibly masked) content of cell (r, c). */
+    T operator()(int r, int c) const {
+        const T& value = cells[r * columns + c];
+        return mask ? mask(owner, r, c, value) : value;
+    }
+
+    /** @brief Get number of rows. */
+    int get_rows() const { return rows; }
+
+    /** @brief Get number of columns. */
+    int get_columns() const { return columns; }
+
+    /** @brief True if the view has no cells. */
+    bool empty() const { return rows == 0 || columns == 0; }
+};
+
+//-----------------------------------------------------
 /**
  * @brief Base template for any board used in board games.
  *
  * @tparam T Type of the elements stored on the board (e.g., char, int, string).
  *
- * Provides core data (rows, columns, matrix) and virtual methods to be
+ * Provides core data (rows, columns, cells) and virtual methods to be
  * implemented by specific games like Tic-Tac-Toe, Connect4, etc.
  */
 template <typename T>
@@ -47,18 +188,149 @@ class Board {
 protected:
     int rows;        ///< Number of rows
     int columns;     ///< Number of columns
-    vector<vector<T>> board; ///< 2D vector for the board
+    BoardCells<T> board; ///< Flat row-major cell storage
     int n_moves = 0; ///< Number of moves made
 
+    /** @brief Read-only access to cell (r, c); writes go through set_cell(). */
+    const T& cell(int r, int c) const { return board.at(r, c); }
+
+    /**
+     * @brief Write cell (r, c), updating the Zobrist hash in O(1).
+     *
+     * The only way a derived board changes a cell, so get_hash() always
+     * matches the contents, whatever the move type (placements, slides,
+     * expiring marks, obstacles, AI simulation and its undo).
+     */
+    void set_cell(int r, int c, const T& value) {
+        T& slot = board.at(r, c);
+        int index = r * columns + c;
+        zobrist ^= cell_key(index, slot) ^ cell_key(index, value);
+        slot = value;
+    }
+
+    /** @brief Set every cell to `value` (used by constructors). */
+    void fill_cells(const T& value) {
+        board.fill(value);
+        rehash();
+    }
+
+    /**
+     * @brief Move a piece of state other than the cells into or out of the hash.
+     *
+     * For state that changes which moves are legal (e.g. Ultimate's forced
+     * sub-board). Call it with the old value and again with the new one.
+     * @param slot Which piece of state (0, 1, ... per board).
+     * @param value Its value.
+     */
+    void toggle_state_key(int slot, int value) {
+        zobrist ^= mix_key((1ull << 63) | ((uint64_t)(uint32_t)slot << 32) | (uint32_t)value);
+    }
+
+    int last_x = -1;      ///< Row of the last applied move, -1 if none (or undone)
+    int last_y = -1;      ///< Column of the last applied move
+    int move_serial = 0;  ///< Bumped on every applied move; keys the cached outcome
+
+    /**
+     * @brief Note a successful update_board() at (x, y).
+     *
+     * Every board calls this when it applies (or undoes, with -1, -1) a move,
+     * so get_outcome() knows its cached result is stale.
+     */
+    void record_move(int x, int y) {
+        last_x = x;
+        last_y = y;
+        ++move_serial;
+    }
+
+    /**
+     * @brief Work out the outcome after the last recorded move by `player`.
+     *
+     * Boards override this to look only at the lines through (last_x, last_y).
+     * The default falls back to the full is_win / is_lose / is_draw scans.
+     */
+    virtual Outcome evaluate_last_move(Player<T>* player) {
+        if (is_win(player)) return Outcome::WIN;
+        if (is_lose(player)) return Outcome::LOSE;
+        if (is_draw(player)) return Outcome::DRAW;
+        return Outcome::ONGOING;
+    }
+
+    /**
+     * @brief Add a placement of `symbol` on every cell holding `blank`.
+     * @return Number of moves in `moves`.
+     */
+    int generate_placements(const T& blank, const T& symbol, MoveList<T>& moves) const {
+        moves.clear();
+        for (int r = 0; r < rows; ++r)
+            for (int c = 0; c < columns; ++c)
+                if (cell(r, c) == blank) moves.add(r, c, symbol);
+        return moves.size();
+    }
+
+    /**
+     * @brief Check for `length` equal symbols in a row through (r, c).
+     *
+     * Walks out from (r, c) along the four axes only, so the cost depends on
+     * `length` and not on the board size.
+     */
+    bool has_line_through(int r, int c, int length) const {
+        static const int dirs[4][2] = {{0, 1}, {1, 0}, {1, 1}, {1, -1}};
+        const T& sym = cell(r, c);
+        for (const auto& d : dirs) {
+            int count = 1;
+            for (int k = 1; count < length; ++k, ++count) {
+                int rr = r + k * d[0], cc = c + k * d[1];
+                if (rr < 0 || rr >= rows || cc < 0 || cc >= columns || !(cell(rr, cc) == sym)) break;
+            }
+            for (int k = 1; count < length; ++k, ++count) {
+                int rr = r - k * d[0], cc = c - k * d[1];
+                if (rr < 0 || rr >= rows || cc < 0 || cc >= columns || !(cell(rr, cc) == sym)) break;
+            }
+            if (count >= length) return true;
+        }
+        return false;
+    }
+
+private:
+    Outcome cached_outcome = Outcome::ONGOING; ///< Result of the last evaluation
+    int outcome_serial = 0;                    ///< move_serial the cached result belongs to
+    uint64_t zobrist = 0;                      ///< XOR of the keys of every cell and state value
+
+    /** @brief SplitMix64 finaliser; spreads structured input over all 64 bits. */
+    static uint64_t mix_key(uint64_t x) {
+        x += 0x9E3779B97F4A7C15ull;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+        return x ^ (x >> 31);
+    }
+
+    /**
+     * @brief Zobrist key of `value` sitting on cell `index`.
+     *
+     * Computed rather than looked up, so any symbol type works without a
+     * key table sized to its alphabet.
+     */
+    static uint64_t cell_key(int index, const T& value) {
+        return mix_key(((uint64_t)(uint32_t)index << 32) ^ (uint64_t)hash<T>()(value));
+    }
+
+    /** @brief Recompute the hash from scratch over every cell. */
+    void rehash() {
+        zobrist = 0;
+        for (int i = 0; i < board.size(); ++i) zobrist ^= cell_key(i, board.data()[i]);
+    }
+
 public:
     /**
      * @brief Construct a board with given dimensions.
      */
     Board(int rows, int columns)
-        : rows(rows), columns(columns), board(rows, vector<T>(columns)) {}
+        : rows(rows), columns(columns), board(rows, columns) {
+        rehash();
+    }
 
     /**
-     * @brief Virtual destructor. Frees allocated board memory.
+     * @brief Virtual destructor.
      */
     virtual ~Board() {}
 
@@ -82,10 +354,34 @@ public:
     virtual bool game_is_over(Player<T>*) = 0;
 
     /**
-     * @brief Return a copy of the current board as a 2D vector.
+     * @brief List every legal move `symbol` can make in the current position.
+     * @param symbol Symbol (or player id) of the side to move.
+     * @param moves Caller-supplied buffer; cleared, then filled.
+     * @return Number of moves generated.
+     */
+    virtual int generate_moves(T symbol, MoveList<T>& moves) const = 0;
+
+    /**
+     * @brief Outcome of the last move, made by `player`.
+     *
+     * Evaluated once per applied move from the lines through that move and
+     * cached; asking again before the next move costs nothing.
+     */
+    Outcome get_outcome(Player<T>* player) {
+        if (outcome_serial != move_serial) {
+            cached_outcome = (last_x < 0) ? Outcome::ONGOING : evaluate_last_move(player);
+            outcome_serial = move_serial;
+        }
+        return cached_outcome;
+    }
+
+    /**
+     * @brief Return a read-only view of the current board (no copy is made).
+     *
+     * Boards that hide their contents override this to return a masked view.
      */
-    vector<vector<T>> get_board_matrix() const {
-        return board;
+    virtual BoardView<T> get_board_view() const {
+        return BoardView<T>(board.data(), rows, columns);
     }
 
     /** @brief Get number of rows. */
@@ -98,9 +394,17 @@ public:
     int get_n_moves() const { return n_moves; }
 
     /** @brief Return content of cell x, y in current board. */
-    T get_cell(int x, int y) {
-        return board[x][y];
+    T get_cell(int x, int y) const {
+        return cell(x, y);
     }
+
+    /**
+     * @brief 64-bit Zobrist hash of the position (cells plus extra state).
+     *
+     * Maintained incrementally by set_cell() and toggle_state_key(), so
+     * reading it is free. It does not include whose turn it is.
+     */
+    uint64_t get_hash() const { return zobrist; }
 };
 
 //-----------------------------------------------------
@@ -111,13 +415,22 @@ public:
  */
 template <typename T>
 class Move {
-    int x;      ///< Row index
-    int y;      ///< Column index
+    int x;      ///< Row index (destination of a sliding move)
+    int y;      ///< Column index (destination of a sliding move)
     T symbol;   ///< Symbol used in the move
+    int from_x; ///< Source row of a sliding move, -1 for a placement
+    int from_y; ///< Source column of a sliding move, -1 for a placement
 
 public:
+    /** @brief Uninitialised move, only for filling move buffers. */
+    Move() = default;
+
     /** @brief Construct a move at (x, y) using a symbol. */
-    Move(int x, int y, T symbol) : x(x), y(y), symbol(symbol) {}
+    Move(int x, int y, T symbol) : x(x), y(y), symbol(symbol), from_x(-1), from_y(-1) {}
+
+    /** @brief Construct a move sliding a symbol from (from_x, from_y) to (x, y). */
+    Move(int from_x, int from_y, int x, int y, T symbol)
+        : x(x), y(y), symbol(symbol), from_x(from_x), from_y(from_y) {}
 
     /** @brief Get row index. */
     int get_x() const { return x; }
@@ -127,6 +440,87 @@ public:
 
     /** @brief Get the move symbol. */
     T get_symbol() const { return symbol; }
+
+    /** @brief Get source row of a sliding move (-1 for a placement). */
+    int get_from_x() const { return from_x; }
+
+    /** @brief Get source column of a sliding move (-1 for a placement). */
+    int get_from_y() const { return from_y; }
+};
+
+//-----------------------------------------------------
+/**
+ * @brief Fixed-capacity move buffer filled by Board<T>::generate_moves().
+ *
+ * @tparam T Type of symbol used in the moves.
+ *
+ * Meant to live on the caller's stack, so listing the moves of a position
+ * never touches the heap. CAPACITY covers the largest move count of any game
+ * here (word Tic-Tac-Toe: 9 cells x 26 letters).
+ */
+template <typename T>
+class MoveList {
+public:
+    static const int CAPACITY = 256; ///< Maximum number of moves held.
+
+private:
+    Move<T> moves[CAPACITY]; ///< Storage; only the first `count` are valid
+    int count = 0;           ///< Number of moves held
+
+public:
+    /** @brief Remove all moves. */
+    void clear() { count = 0; }
+
+    /** @brief Append a placement at (x, y). */
+    void add(int x, int y, T symbol) { moves[count++] = Move<T>(x, y, symbol); }
+
+    /** @brief Append any move. */
+    void add(const Move<T>& move) { moves[count++] = move; }
+
+    /** @brief Number of moves held. */
+    int size() const { return count; }
+
+    /** @brief True if there are no moves. */
+    bool empty() const { return count == 0; }
+
+    /** @brief Access move i. */
+    Move<T>& operator[](int i) { return moves[i]; }
+    const Move<T>& operator[](int i) const { return moves[i]; }
+
+    Move<T>* begin() { return moves; }
+    Move<T>* end() { return moves + count; }
+    const Move<T>* begin() const { return moves; }
+    const Move<T>* end() const { return moves + count; }
+};
+
+//-----------------------------------------------------
+/**
+ * @brief Reusable storage for the move a UI or agent hands out.
+ *
+ * @tparam M Concrete move type (Move<T> or a subclass such as FourByFour_Move).
+ *
+ * get_move() returns a pointer into a slot owned by the UI or agent instead
+ * of a fresh heap object. The board consumes each move before the same owner
+ * is asked for the next one, so a single slot per move type is enough: no
+ * allocation per turn and nothing for the caller to free.
+ */
+template <typename M>
+class MoveSlot {
+    optional<M> move; ///< Last move handed out
+
+public:
+    /**
+     * @brief Build a move in the slot, replacing the previous one.
+     * @return Pointer valid until the next call on this slot.
+     */
+    template <typename... Args>
+    M* emplace(Args&&... args) {
+        move.emplace(forward<Args>(args)...);
+        return &*move;
+    }
+
+    /** @brief Copy a move into the slot, replacing the previous one. */
+    M* store(const M& m) { return emplace(m); }
 };
 
 //-----------------------------------------------------
@@ -178,6 +572,7 @@ template <typename T>
 class UI {
 protected:
     int cell_width; ///< Width of each displayed board cell
+    MoveSlot<Move<T>> move_slot; ///< Storage for the moves returned by get_move
 
     /**
      * @brief Ask the user for the player's name.
@@ -222,6 +617,7 @@ public:
 
     /**
      * @brief Ask the user (or AI) to make a move.
+     * @return A move owned by the UI, valid until its next get_move call.
      */
     virtual Move<T>* get_move(Player<T>*) = 0;
 
@@ -236,14 +632,13 @@ public:
     virtual Player<T>* create_player(string& name, T symbol, PlayerType type);
 
     /**
-     * @brief Display the current board matrix in formatted form.
+     * @brief Display the current board in formatted form.
      */
+    virtual void display_board_matrix(const BoardView<T>& view) const {
+        if (view.empty()) return;
 
-    virtual void display_board_matrix(const vector<vector<T>>& matrix) const {
-        if (matrix.empty() || matrix[0].empty()) return;
-
-        int rows = matrix.size();
-        int cols = matrix[0].size();
+        int rows = view.get_rows();
+        int cols = view.get_columns();
 
         cout << "\n   ";
         for (int j = 0; j < cols; ++j)
@@ -253,7 +648,7 @@ public:
         for (int i = 0; i < rows; ++i) {
             cout << setw(2) << i << " |";
             for (int j = 0; j < cols; ++j)
-                cout << setw(cell_width) << matrix[i][j] << " |";
+                cout << setw(cell_width) << view(i, j) << " |";
             cout << "\n   " << string((cell_width + 2) * cols, '-') << "\n";
         }
         cout << endl;
@@ -288,7 +683,7 @@ public:
      * @brief Run the main game loop until someone wins or the game ends.
      */
     void run() {
-        ui->display_board_matrix(boardPtr->get_board_matrix());
+        ui->display_board_matrix(boardPtr->get_board_view());
         Player<T>* currentPlayer = players[0];
 
         while (true) {
@@ -299,22 +694,133 @@ public:
                 while (!boardPtr->update_board(move))
                     move = ui->get_move(currentPlayer);
 
-                ui->display_board_matrix(boardPtr->get_board_matrix());
+                ui->display_board_matrix(boardPtr->get_board_view());
 
-                if (boardPtr->is_win(currentPlayer)) {
+                switch (boardPtr->get_outcome(currentPlayer)) {
+                case Outcome::WIN:
                     ui->display_message(currentPlayer->get_name() + " wins!");
                     return;
-                }
-                if (boardPtr->is_lose(currentPlayer)) {
+                case Outcome::LOSE:
                     ui->display_message(players[1 - i]->get_name() + " wins!");
                     return;
-                }
-                if (boardPtr->is_draw(currentPlayer)) {
+                case Outcome::DRAW:
                     ui->display_message("Draw!");
                     return;
+                case Outcome::ONGOING:
+                    break;
+                }
+            }
+        }
+    }
+};
+
+//-----------------------------------------------------
+/**
+ * @brief A non-interactive move producer (computer engine).
+ *
+ * @tparam T Type of symbol used on the board.
+ *
+ * Unlike UI<T>::get_move, an agent never reads input or prints anything,
+ * so it can be used to play games headless.
+ */
+template <typename T>
+class Agent {
+public:
+    virtual ~Agent() {}
+
+    /**
+     * @brief Choose a move for the given player on its board.
+     * @return A move owned by the agent (see MoveSlot), valid until its next
+     *         get_move call, or nullptr if no move is possible.
+     */
+    virtual Move<T>* get_move(Player<T>* player) = 0;
+
+protected:
+    MoveSlot<Move<T>> move_slot; ///< Storage for the returned moves
+};
+
+//-----------------------------------------------------
+/**
+ * @brief Compact record of one headless game.
+ */
+struct SelfPlayResult {
+    int winner = -1;            ///< Index (0 or 1) of the winning player, -1 for a draw
+    int n_moves = 0;            ///< Number of moves applied
+    long long think_ns[2] = {0, 0}; ///< Total time each player spent choosing moves
+    long long max_move_ns = 0;  ///< Slowest single move of the game
+};
+
+//-----------------------------------------------------
+/**
+ * @brief Plays a board between two agents without any UI.
+ *
+ * @tparam T Type of symbol used on the board.
+ *
+ * Sibling of GameManager for automated self-play: no board rendering and no
+ * prompts, only the game loop and per-move timing.
+ */
+template <typename T>
+class SelfPlayManager {
+    Board<T>* boardPtr;     ///< Game board
+    Player<T>* players[2];  ///< Two players (symbols and names)
+    Agent<T>* agents[2];    ///< Move producer for each player
+    int max_moves;          ///< Moves after which the game is declared a draw
+    int max_retries;        ///< Rejected moves in a row before a player forfeits
+
+public:
+    /**
+     * @brief Construct a self-play manager with board, players, and agents.
+     */
+    SelfPlayManager(Board<T>* b, Player<T>* p[2], Agent<T>* a[2],
+                    int max_moves = 1000, int max_retries = 1000)
+        : boardPtr(b), max_moves(max_moves), max_retries(max_retries) {
+        for (int i : {0, 1}) {
+            players[i] = p[i];
+            agents[i] = a[i];
+            players[i]->set_board_ptr(b);
+        }
+    }
+
+    /**
+     * @brief Play one game to the end.
+     * @param move_ns Optional buffer that receives the time of every applied move (ns).
+     * @return Winner, move count and timing of the game.
+     */
+    SelfPlayResult run(vector<long long>* move_ns = nullptr) {
+        typedef chrono::steady_clock clock;
+        SelfPlayResult result;
+        if (move_ns) move_ns->clear();
+
+        while (result.n_moves < max_moves) {
+            for (int i : {0, 1}) {
+                Player<T>* currentPlayer = players[i];
+
+                clock::time_point start = clock::now();
+                Move<T>* move = agents[i]->get_move(currentPlayer);
+                int retries = 0;
+                while (move && !boardPtr->update_board(move)) {
+                    if (++retries == max_retries) {
+                        result.winner = 1 - i; // Forfeit: agent keeps proposing illegal moves
+                        return result;
+                    }
+                    move = agents[i]->get_move(currentPlayer);
                 }
+                long long ns = chrono::duration_cast<chrono::nanoseconds>(clock::now() - start).count();
+                if (!move) return result; // No move available: draw
+
+                result.n_moves++;
+                result.think_ns[i] += ns;
+                if (ns > result.max_move_ns) result.max_move_ns = ns;
+                if (move_ns) move_ns->push_back(ns);
+
+                Outcome outcome = boardPtr->get_outcome(currentPlayer);
+                if (outcome == Outcome::WIN) result.winner = i;
+                if (outcome == Outcome::LOSE) result.winner = 1 - i;
+                if (outcome != Outcome::ONGOING) return result;
+                if (result.n_moves >= max_moves) return result;
             }
         }
+        return result;
     }
 };
 
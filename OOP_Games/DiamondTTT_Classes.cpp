@@ -21,7 +21,7 @@ const char Diamond_Board::blank_symbol = ' ';
 Diamond_Board::Diamond_Board() : Board<char>(5, 5) {
     for (int i = 0; i < rows; ++i)
         for (int j = 0; j < columns; ++j)
-            board[i][j] = blank_symbol;
+            set_cell(i, j, blank_symbol);
 
     valid_positions.clear();
     for (int r = 0; r < rows; ++r) {
@@ -41,16 +41,17 @@ bool Diamond_Board::valid_cell(int r, int c) const {
     return (abs(r - 2) + abs(c - 2) <= 2);
 }
 
-vector<pair<int,int>> Diamond_Board::get_valid_positions() const {
+const vector<pair<int,int>>& Diamond_Board::get_valid_positions() const {
     return valid_positions;
 }
 
-vector<pair<int,int>> Diamond_Board::get_empty_positions() const {
-    vector<pair<int,int>> empties;
+int Diamond_Board::generate_moves(char symbol, MoveList<char>& moves) const {
+    // Cells outside the diamond also hold blank_symbol, so walk the valid ones
+    moves.clear();
     for (auto p : valid_positions) {
-        if (board[p.first][p.second] == blank_symbol) empties.push_back(p);
+        if (cell(p.first, p.second) == blank_symbol) moves.add(p.first, p.second, symbol);
     }
-    return empties;
+    return moves.size();
 }
 
 bool Diamond_Board::update_board(Move<char>* move) {
@@ -62,12 +63,13 @@ bool Diamond_Board::update_board(Move<char>* move) {
         cout << "Invalid move: (" << r << "," << c << ") is not a diamond cell.\n";
         return false;
     }
-    if (board[r][c] != blank_symbol) {
+    if (cell(r, c) != blank_symbol) {
         cout << "Invalid move: Cell occupied.\n";
         return false;
     }
-    board[r][c] = s;
+    set_cell(r, c, s);
     ++n_moves;
+    record_move(r, c);
     return true;
 }
 
@@ -75,16 +77,16 @@ bool Diamond_Board::update_board(Move<char>* move) {
 
 bool Diamond_Board::make_temp_move(int r, int c, char symbol) {
     if (!valid_cell(r, c)) return false;
-    if (board[r][c] != blank_symbol) return false;
-    board[r][c] = symbol;
+    if (cell(r, c) != blank_symbol) return false;
+    set_cell(r, c, symbol);
     ++n_moves;
     return true;
 }
 
 void Diamond_Board::undo_temp_move(int r, int c) {
     if (!valid_cell(r, c)) return;
-    if (board[r][c] != blank_symbol) {
-        board[r][c] = blank_symbol;
+    if (cell(r, c) != blank_symbol) {
+        set_cell(r, c, blank_symbol);
         --n_moves;
     }
 }
@@ -105,7 +107,7 @@ bool Diamond_Board::exists_contiguous_line_including(int r, int c, int len, int
             int cc = sc + k * dcr;
             if (rr < 0 || rr >= rows || cc < 0 || cc >= columns) { ok = false; break; }
             if (!valid_cell(rr, cc)) { ok = false; break; }
-            if (board[rr][cc] != symbol) { ok = false; break; }
+            if (cell(rr, cc) != symbol) { ok = false; break; }
         }
         if (ok) return true;
     }
@@ -137,7 +139,7 @@ bool Diamond_Board::is_win(Player<char>* player) {
     char sym = player->get_symbol();
     for (auto p : valid_positions) {
         int r = p.first, c = p.second;
-        if (board[r][c] == sym) {
+        if (cell(r, c) == sym) {
             if (placement_creates_win(r, c, sym)) return true;
         }
     }
@@ -147,7 +149,7 @@ bool Diamond_Board::is_win(Player<char>* player) {
 bool Diamond_Board::is_lose(Player<char>* player) { return false; }
 
 bool Diamond_Board::is_draw(Player<char>* player) {
-    for (auto p : valid_positions) if (board[p.first][p.second] == blank_symbol) return false;
+    for (auto p : valid_positions) if (cell(p.first, p.second) == blank_symbol) return false;
     Player<char> tmpX("tmpX",'X',PlayerType::HUMAN);
     Player<char> tmpO("tmpO",'O',PlayerType::HUMAN);
     if (!is_win(&tmpX) && !is_win(&tmpO)) return true;
@@ -158,6 +160,23 @@ bool Diamond_Board::game_is_over(Player<char>* player) {
     return is_win(player) || is_draw(player);
 }
 
+bool Diamond_Board::move_completes_win(int r, int c, char symbol) const {
+    for (int dir = 0; dir < 4; ++dir) {
+        for (int t = -3; t <= 3; ++t) {
+            int rr = r + t * dr[dir], cc = c + t * dc[dir];
+            if (valid_cell(rr, cc) && cell(rr, cc) == symbol && placement_creates_win(rr, cc, symbol))
+                return true;
+        }
+    }
+    return false;
+}
+
+Outcome Diamond_Board::evaluate_last_move(Player<char>* player) {
+    if (move_completes_win(last_x, last_y, player->get_symbol())) return Outcome::WIN;
+    if (n_moves == (int)valid_positions.size()) return Outcome::DRAW;
+    return Outcome::ONGOING;
+}
+
 // --------------------------------------------------------------------
 // Diamond_AIPlayer Implementation
 // --------------------------------------------------------------------
@@ -165,51 +184,56 @@ bool Diamond_Board::game_is_over(Player<char>* player) {
 Diamond_AIPlayer::Diamond_AIPlayer(const string& name, char symbol)
     : Player<char>(name, symbol, PlayerType::AI) {}
 
-static string make_key_from_positions(const vector<pair<int,int>>& valid_positions, const vector<vector<char>>& board_mat) {
-    string key;
-    key.reserve(valid_positions.size());
-    for (auto &p : valid_positions) {
-        key.push_back(board_mat[p.first][p.second]);
-    }
-    return key;
+Move<char> Diamond_AIPlayer::get_smart_move(Diamond_Board* board, char opponent_symbol) {
+    cout << "AI " << get_name() << " is thinking (optimized full backtracking)...\n";
+    return choose_move(board, opponent_symbol);
 }
 
-string Diamond_AIPlayer::board_key(Diamond_Board* board) const {
-    auto valid_pos = board->get_valid_positions();
-    auto mat = board->get_board_matrix();
-    return make_key_from_positions(valid_pos, mat);
+Move<char> Diamond_AIPlayer::choose_move(Diamond_Board* board, char opponent_symbol) {
+    Diamond_Position pos(board, get_symbol());
+    SearchResult<char> result = search.search(pos, (int)board->get_valid_positions().size());
+    if (!result.found) return Move<char>(0,0,get_symbol());
+    return Move<char>(result.best.get_x(), result.best.get_y(), get_symbol());
 }
 
-Move<char>* Diamond_AIPlayer::get_smart_move(Diamond_Board* board, char opponent_symbol) {
-    // Logic: Tries to find immediate win, if not, runs minimax.
-    
-    cout << "AI " << get_name() << " is thinking (optimized full backtracking)...\n";
-    memo.clear();
+// --------------------------------------------------------------------
+// Diamond_Position Implementation
+// --------------------------------------------------------------------
+
+Diamond_Position::Diamond_Position(Diamond_Board* board, char symbol) : board(board), side(symbol) {}
+
+int Diamond_Position::generate_moves(MoveList<char>& moves) const {
+    board->generate_moves(side, moves);
+    for (int i = 1; i < moves.size(); ++i) {
+        if (moves[i].get_x() == 2 && moves[i].get_y() == 2) {
+            swap(moves[0], moves[i]);
+            break;
+        }
+    }
+    return moves.size();
+}
+
+void Diamond_Position::make_move(const Move<char>& move) {
+    board->make_temp_move(move.get_x(), move.get_y(), side);
+    last_x = move.get_x();
+    last_y = move.get_y();
+    side = (side == 'X') ? 'O' : 'X';
+}
 
-    // Fallback to simple logic if needed
-    vector<pair<int,int>> empties = board->get_empty_positions();
-    if (empties.empty()) return new Move<char>(0,0,get_symbol());
-    
-    // ... (Minimax call logic) ...
-    int best_score = -2;
-    vector<pair<int,int>> best_moves;
-    pair<int,int> chosen = tiebreak_choose(empties); // Placeholder logic
-    return new Move<char>(chosen.first, chosen.second, get_symbol());
+void Diamond_Position::undo_move(const Move<char>& move) {
+    board->undo_temp_move(move.get_x(), move.get_y());
+    side = (side == 'X') ? 'O' : 'X';
 }
 
-int Diamond_AIPlayer::backtrack_minimax(Diamond_Board* board, char current_symbol, int alpha, int beta) {
-    // Standard Minimax with Alpha-Beta Pruning and Memoization
-    string key = board_key(board) + current_symbol;
-    if (memo.count(key)) return memo[key];
-    
-    // ... [Recursive logic] ...
-    return 0; 
+Outcome Diamond_Position::last_move_outcome() const {
+    char mover = (side == 'X') ? 'O' : 'X';
+    if (board->move_completes_win(last_x, last_y, mover)) return Outcome::WIN;
+    if (board->get_n_moves() == (int)board->get_valid_positions().size()) return Outcome::DRAW;
+    return Outcome::ONGOING;
 }
 
-pair<int,int> Diamond_AIPlayer::tiebreak_choose(const vector<pair<int,int>>& choices) const {
-    pair<int,int> center = {2,2};
-    for (auto p : choices) if (p == center) return p;
-    return choices.front();
+uint64_t Diamond_Position::key() const {
+    return board->get_hash() ^ search_side_key(side);
 }
 
 // --------------------------------------------------------------------
@@ -220,7 +244,7 @@ Diamond_UI::Diamond_UI(Diamond_Board* board) : UI<char>("Welcome to Diamond Tic-
     srand((unsigned)time(nullptr));
 }
 
-void Diamond_UI::display_board_matrix(const vector<vector<char>>& matrix) const {}
+void Diamond_UI::display_board_matrix(const BoardView<char>&) const {}
 
 Player<char>** Diamond_UI::setup_players() {
     Player<char>** players = new Player<char>*[2];
@@ -232,13 +256,12 @@ Player<char>* Diamond_UI::create_player(string& name, char symbol, PlayerType ty
     return new Player<char>(name, symbol, type);
 }
 
-void print_diamond_board(const Diamond_Board* board) {
-    const auto& mat = board->get_board_matrix();
+void print_diamond_board(const Diamond_Board*) {
     cout << "\n       COLUMNS\n";
 
 }
 
 Move<char>* Diamond_UI::get_move(Player<char>* player) {
     print_diamond_board(board_ptr);
-    return new Move<char>(0,0, player->get_symbol()); // Placeholder return
+    return move_slot.emplace(0,0, player->get_symbol()); // Placeholder return
 }
\ No newline at end of file
@@ -10,9 +10,9 @@
 #define DIAMONDTTT_CLASSES_H
 
 #include "BoardGame_Classes.h"
+#include "Search_Classes.h"
 #include <string>
 #include <vector>
-#include <unordered_map>
 
 using namespace std;
 
@@ -63,6 +63,16 @@ public:
      */
     virtual bool game_is_over(Player<char>* player) override;
 
+    /**
+     * @brief Win if a cell in line with the last move now has its 3- and 4-lines.
+     */
+    Outcome evaluate_last_move(Player<char>* player) override;
+
+    /**
+     * @brief Every empty diamond cell.
+     */
+    int generate_moves(char symbol, MoveList<char>& moves) const override;
+
 
     /**
      * @brief Checks if a coordinate is within the diamond shape.
@@ -75,12 +85,7 @@ public:
     /**
      * @brief Gets all valid coordinates in the diamond.
      */
-    vector<pair<int,int>> get_valid_positions() const;
-
-    /**
-     * @brief Gets all currently empty valid positions.
-     */
-    vector<pair<int,int>> get_empty_positions() const;
+    const vector<pair<int,int>>& get_valid_positions() const;
 
     // --- AI Simulation Helpers ---
     bool make_temp_move(int r, int c, char symbol);
@@ -92,6 +97,14 @@ public:
      */
     bool placement_creates_win(int r, int c, char symbol) const;
 
+    /**
+     * @brief Checks if the mark just placed at (r,c) won the game for `symbol`.
+     *
+     * A cell can only gain a 3- or 4-line that contains (r,c), so only cells
+     * within 3 steps of it along one of the four directions are tried.
+     */
+    bool move_completes_win(int r, int c, char symbol) const;
+
     static const char blank_symbol;
 
 private:
@@ -103,9 +116,39 @@ private:
     vector<pair<int,int>> valid_positions; ///< Caches valid diamond coordinates.
 };
 
+/**
+ * @class Diamond_Position
+ * @brief Search view of a Diamond_Board for AlphaBetaSearch.
+ *
+ * Moves come centre first. With only 13 cells the search goes to the end
+ * of the game, so there is no heuristic.
+ */
+class Diamond_Position {
+public:
+    typedef char Symbol;
+
+    /**
+     * @brief Starts a search on `board` with `symbol` to move.
+     */
+    Diamond_Position(Diamond_Board* board, char symbol);
+
+    int generate_moves(MoveList<char>& moves) const;
+    void make_move(const Move<char>& move);
+    void undo_move(const Move<char>& move);
+    Outcome last_move_outcome() const;
+    int evaluate() const { return 0; }
+    uint64_t key() const;
+
+private:
+    Diamond_Board* board;
+    char side;       ///< Side to move.
+    int last_x = -1; ///< Row of the last mark.
+    int last_y = -1; ///< Column of the last mark.
+};
+
 /**
  * @class Diamond_AIPlayer
- * @brief AI player using backtracking/minimax with memoization.
+ * @brief AI player searching the game to the end with AlphaBetaSearch.
  */
 class Diamond_AIPlayer : public Player<char> {
 public:
@@ -115,13 +158,18 @@ public:
     /**
      * @brief Calculates best move for AI.
      */
-    Move<char>* get_smart_move(Diamond_Board* board, char opponent_symbol);
+    Move<char> get_smart_move(Diamond_Board* board, char opponent_symbol);
+
+    /**
+     * @brief Same as get_smart_move() without any console output.
+     */
+    Move<char> choose_move(Diamond_Board* board, char opponent_symbol);
+
+    /** @brief Positions visited by all searches of this player so far. */
+    long long get_search_nodes() const { return search.nodes_searched(); }
 
 private:
-    int backtrack_minimax(Diamond_Board* board, char current_symbol, int alpha, int beta);
-    string board_key(Diamond_Board* board) const;
-    unordered_map<string,int> memo; ///< Transposition table for caching board states.
-    pair<int,int> tiebreak_choose(const vector<pair<int,int>>& choices) const;
+    AlphaBetaSearch<Diamond_Position> search{18}; ///< Full-depth search engine.
 };
 
 /**
@@ -137,7 +185,7 @@ public:
     virtual Player<char>** setup_players() override;
     virtual Player<char>* create_player(string& name, char symbol, PlayerType type) override;
     virtual Move<char>* get_move(Player<char>* player) override;
-    virtual void display_board_matrix(const vector<vector<char>>& matrix) const override;
+    virtual void display_board_matrix(const BoardView<char>& view) const override;
 };
 
 #endif
\ No newline at end of file
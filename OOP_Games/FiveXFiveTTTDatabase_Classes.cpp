@@ -0,0 +1,199 @@
+/**
+ * @file FiveXFiveTTTDatabase_Classes.cpp
+ * @brief Implementation of the 5x5 Tic-Tac-Toe solved-positions database.
+ */
+
+#include "FiveXFiveTTTDatabase_Classes.h"
+#include "FiveXFiveTTTSolver_Classes.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+namespace {
+
+const char MAGIC[8] = {'F', 'X', 'F', 'D', 'B', '1', '\0', '\0'};
+const size_t HEADER_SIZE = 24; ///< Magic, plies, entry count
+
+const int CELLS = FxFTTT_Solver::CELLS;
+const uint32_t FULL = (1u << CELLS) - 1;
+
+uint64_t pack(uint64_t key, int score, int cell) {
+    return key << 14 | uint64_t(score + 64) << 5 | uint64_t(cell);
+}
+
+/** @brief Side to move's and opponent's cells of a canonical key. */
+uint32_t mover_of(uint64_t key) { return uint32_t(key) & FULL; }
+uint32_t other_of(uint64_t key) { return uint32_t(key >> CELLS); }
+
+} // namespace
+
+const char* FxFTTT_Database::DEFAULT_PATH = "fxfttt_db.bin";
+
+FxFTTT_Database::~FxFTTT_Database() { close(); }
+
+bool FxFTTT_Database::open(const string& path) {
+    close();
+
+#ifndef _WIN32
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    void* data = MAP_FAILED;
+    if (fstat(fd, &st) == 0 && st.st_size >= (off_t)HEADER_SIZE)
+        data = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd); // The mapping outlives the descriptor
+    if (data == MAP_FAILED) return false;
+    mapping = data;
+    mapping_size = st.st_size;
+    const char* bytes = static_cast<const char*>(data);
+#else
+    ifstream in(path, ios::binary);
+    if (!in) return false;
+    in.seekg(0, ios::end);
+    size_t size = (size_t)in.tellg();
+    if (size < HEADER_SIZE) return false;
+    fallback.resize((size + 7) / 8);
+    in.seekg(0);
+    in.read(reinterpret_cast<char*>(fallback.data()), size);
+    mapping_size = size;
+    const char* bytes = reinterpret_cast<const char*>(fallback.data());
+#endif
+
+    uint64_t header[2];
+    memcpy(header, bytes + sizeof(MAGIC), sizeof(header));
+    if (memcmp(bytes, MAGIC, sizeof(MAGIC)) != 0 || header[1] > (mapping_size - HEADER_SIZE) / 8) {
+        close();
+        return false;
+    }
+    plies = (int)header[0];
+    count = (size_t)header[1];
+    entries = reinterpret_cast<const uint64_t*>(bytes + HEADER_SIZE);
+    return true;
+}
+
+void FxFTTT_Database::close() {
+#ifndef _WIN32
+    if (mapping) munmap(mapping, mapping_size);
+#endif
+    mapping = nullptr;
+    mapping_size = 0;
+    fallback.clear();
+    entries = nullptr;
+    count = 0;
+    plies = 0;
+}
+
+bool FxFTTT_Database::lookup(uint32_t mover, uint32_t other, int& cell, int* score) const {
+    if (count == 0) return false;
+    int symmetry;
+    uint64_t key = FxFTTT_Solver::canonical(mover, other, &symmetry);
+    const uint64_t* end = entries + count;
+    const uint64_t* it = lower_bound(entries, end, key << 14);
+    if (it == end || (*it >> 14) != key) return false;
+
+    // The stored cell is in the canonical orientation; find the one that maps onto it
+    int canonical_cell = int(*it & 0x1F);
+    for (int i = 0; i < CELLS; ++i)
+        if (FxFTTT_Solver::transform_cell(symmetry, i) == canonical_cell) cell = i;
+    if (score) *score = int((*it >> 5) & 0x1FF) - 64;
+    return true;
+}
+
+const FxFTTT_Database& FxFTTT_Database::shared() {
+    static FxFTTT_Database database;
+    static bool opened = database.open(DEFAULT_PATH);
+    (void)opened;
+    return database;
+}
+
+/**
+ * Positions are collected ply by ply, one per symmetry class. Only the
+ * last ply is solved, its positions shared out among the threads (each
+ * with its own solver); a score is the final count difference, whatever
+ * was played before, so every shallower position just takes the best of
+ * its children's negated scores.
+ */
+vector<uint64_t> FxFTTT_Database::build(const FxFTTTDatabaseOptions& options) {
+    int last = min(options.plies, FxFTTT_Solver::LAST_MOVE - 1);
+    vector<vector<uint64_t>> levels(last + 1);
+    levels[0].push_back(0);
+    for (int ply = 0; ply < last; ++ply) {
+        unordered_set<uint64_t> seen;
+        for (uint64_t key : levels[ply])
+            for (int cell = 0; cell < CELLS; ++cell) {
+                uint32_t mover = mover_of(key), other = other_of(key);
+                if ((mover | other) >> cell & 1) continue;
+                uint64_t child = FxFTTT_Solver::canonical(other, mover | (1u << cell));
+                if (seen.insert(child).second) levels[ply + 1].push_back(child);
+            }
+    }
+
+    const vector<uint64_t>& deepest = levels[last];
+    vector<uint64_t> solved(deepest.size());
+    atomic<size_t> next(0);
+    atomic<int> done(0);
+    mutex progress_lock;
+    auto work = [&] {
+        FxFTTT_Solver solver;
+        for (size_t i = next++; i < deepest.size(); i = next++) {
+            int score;
+            int cell = solver.best_cell(mover_of(deepest[i]), other_of(deepest[i]), &score);
+            solved[i] = pack(deepest[i], score, cell);
+            int n = ++done;
+            if (options.progress) {
+                lock_guard<mutex> lock(progress_lock);
+                options.progress(n, (int)deepest.size());
+            }
+        }
+    };
+    int threads = options.threads > 0 ? options.threads : max(1, (int)thread::hardware_concurrency());
+    vector<thread> pool;
+    for (int t = 1; t < threads; ++t) pool.emplace_back(work);
+    work();
+    for (thread& t : pool) t.join();
+
+    unordered_map<uint64_t, int> scores;
+    for (uint64_t entry : solved) scores[entry >> 14] = int((entry >> 5) & 0x1FF) - 64;
+    vector<uint64_t> entries = solved;
+    for (int ply = last - 1; ply >= 0; --ply)
+        for (uint64_t key : levels[ply]) {
+            uint32_t mover = mover_of(key), other = other_of(key);
+            int best = 0, best_cell = -1;
+            for (int cell = 0; cell < CELLS; ++cell) {
+                if ((mover | other) >> cell & 1) continue;
+                int score = -scores.at(FxFTTT_Solver::canonical(other, mover | (1u << cell)));
+                if (best_cell < 0 || score > best) {
+                    best = score;
+                    best_cell = cell;
+                }
+            }
+            scores[key] = best;
+            entries.push_back(pack(key, best, best_cell));
+        }
+    sort(entries.begin(), entries.end());
+    return entries;
+}
+
+bool FxFTTT_Database::write(const string& path, const vector<uint64_t>& entries, int plies) {
+    ofstream out(path, ios::binary);
+    if (!out) return false;
+    uint64_t header[2] = {uint64_t(plies), uint64_t(entries.size())};
+    out.write(MAGIC, sizeof(MAGIC));
+    out.write(reinterpret_cast<const char*>(header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(uint64_t));
+    return bool(out);
+}
@@ -0,0 +1,105 @@
+/**
+ * @file FiveXFiveTTTDatabase_Classes.h
+ * @brief Database of solved 5x5 Tic-Tac-Toe positions.
+ *
+ * Holds the perfect-play score and best cell of every position of the
+ * first few moves, one entry per symmetry class. It is built offline by
+ * the `fxfttt_db` tool, solving in parallel, and stored as a sorted array
+ * of 64-bit entries that the game maps into memory and bisects.
+ */
+
+#ifndef FIVEXFIVETTTDATABASE_CLASSES_H
+#define FIVEXFIVETTTDATABASE_CLASSES_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/**
+ * @struct FxFTTTDatabaseOptions
+ * @brief What FxFTTT_Database::build() covers and how.
+ */
+struct FxFTTTDatabaseOptions {
+    int plies = 2;     ///< Every position with at most this many moves played.
+    int threads = 0;   ///< Solver threads; 0 for one per core.
+    function<void(int done, int total)> progress; ///< Called after each solved position, if set.
+};
+
+/**
+ * @class FxFTTT_Database
+ * @brief Read-only view of a solved-positions file, and its builder.
+ *
+ * File layout (native byte order): the 8-byte magic "FXFDB1\0\0", the
+ * number of plies and of entries as two 64-bit integers, then the entries
+ * in increasing order. An entry packs `key << 14 | (score + 64) << 5 | cell`:
+ * - `key` is FxFTTT_Solver::canonical() of the side to move's and the
+ *   opponent's cells, so the 8 symmetric images of a position share it;
+ * - `score` is the final three-in-a-row difference for the side to move;
+ * - `cell` (r * 5 + c) is a best move in the canonical orientation.
+ */
+class FxFTTT_Database {
+public:
+    FxFTTT_Database() = default;
+    ~FxFTTT_Database();
+    FxFTTT_Database(const FxFTTT_Database&) = delete;
+    FxFTTT_Database& operator=(const FxFTTT_Database&) = delete;
+
+    /** @brief Name of the database the game loads from its working directory. */
+    static const char* DEFAULT_PATH;
+
+    /**
+     * @brief Maps the database at `path`, replacing any open one.
+     * @return false (and an empty database) if the file is missing or malformed.
+     */
+    bool open(const string& path);
+
+    /** @brief Unmaps the database. */
+    void close();
+
+    /** @brief Number of positions in the database. */
+    size_t size() const { return count; }
+
+    /** @brief Plies the database was built to. */
+    int get_plies() const { return plies; }
+
+    /**
+     * @brief Looks up the position where the side to move owns `mover` and
+     * the opponent `other` (FxFTTT_Solver masks).
+     * @param cell Receives the cell to play, r * 5 + c.
+     * @param score Optional, receives the perfect-play score.
+     * @return true if the position is in the database.
+     */
+    bool lookup(uint32_t mover, uint32_t other, int& cell, int* score = nullptr) const;
+
+    /**
+     * @brief The database found at DEFAULT_PATH, mapped on first use and
+     * shared by every board; empty if there is no such file.
+     */
+    static const FxFTTT_Database& shared();
+
+    /**
+     * @brief Solves every position up to `options.plies` moves and returns
+     * the sorted entries.
+     */
+    static vector<uint64_t> build(const FxFTTTDatabaseOptions& options);
+
+    /**
+     * @brief Writes `entries` (sorted, as returned by build()) to `path`.
+     * @return false if the file cannot be written.
+     */
+    static bool write(const string& path, const vector<uint64_t>& entries, int plies);
+
+private:
+    const uint64_t* entries = nullptr; ///< Into the mapping (or `fallback`).
+    size_t count = 0;
+    int plies = 0;
+    void* mapping = nullptr;           ///< Start of the mapped file, if mapped.
+    size_t mapping_size = 0;
+    vector<uint64_t> fallback;         ///< File contents where mmap is unavailable.
+};
+
+#endif // FIVEXFIVETTTDATABASE_CLASSES_H
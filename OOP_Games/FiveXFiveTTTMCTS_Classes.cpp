@@ -0,0 +1,173 @@
+/**
+ * @file FiveXFiveTTTMCTS_Classes.cpp
+ * @brief Implementation of the 5x5 Tic-Tac-Toe Monte Carlo tree search.
+ */
+
+#include "FiveXFiveTTTMCTS_Classes.h"
+#include "FiveXFiveTTTSolver_Classes.h"
+#include <chrono>
+#include <cmath>
+
+using namespace std;
+
+namespace {
+
+const int CELLS = FxFTTT_Solver::CELLS;
+const uint32_t FULL = (1u << CELLS) - 1;
+
+int popcount(uint32_t bits) { return __builtin_popcount(bits); }
+
+} // namespace
+
+FxFTTT_MCTS::FxFTTT_MCTS(unsigned seed, double exploration) : rng(seed), exploration(exploration) {}
+
+void FxFTTT_MCTS::clear() {
+    nodes.clear();
+}
+
+long long FxFTTT_MCTS::get_root_visits() const {
+    return nodes.empty() ? 0 : nodes[0].visits;
+}
+
+int FxFTTT_MCTS::add_node(uint32_t mover, uint32_t other, int cell) {
+    Node node;
+    node.cell = (signed char)cell;
+    if (popcount(mover | other) < FxFTTT_Solver::LAST_MOVE) node.untried = ~(mover | other) & FULL;
+    nodes.push_back(node);
+    return (int)nodes.size() - 1;
+}
+
+int FxFTTT_MCTS::child_with(int node, int cell) const {
+    for (int c = nodes[node].first_child; c >= 0; c = nodes[c].next_sibling)
+        if (nodes[c].cell == cell) return c;
+    return -1;
+}
+
+/**
+ * @brief Makes `node` the root, keeping only its subtree (copied breadth
+ * first, so the pool does not fill up with dead branches over a game).
+ */
+void FxFTTT_MCTS::reroot(int node) {
+    vector<Node> kept;
+    kept.push_back(nodes[node]);
+    kept[0].next_sibling = -1;
+    for (size_t i = 0; i < kept.size(); ++i) {
+        int old_child = kept[i].first_child;
+        kept[i].first_child = -1;
+        int last = -1;
+        for (int c = old_child; c >= 0; c = nodes[c].next_sibling) {
+            kept.push_back(nodes[c]);
+            int copy = (int)kept.size() - 1;
+            kept[copy].next_sibling = -1;
+            if (last < 0) kept[i].first_child = copy;
+            else kept[last].next_sibling = copy;
+            last = copy;
+        }
+    }
+    nodes.swap(kept);
+}
+
+/**
+ * @brief Plays the game out at random: a partial Fisher-Yates shuffle of
+ * the empty cells gives the order, the sides alternating from `mover`.
+ * @return 1, 1/2 or 0 for `mover`.
+ */
+double FxFTTT_MCTS::playout(uint32_t mover, uint32_t other) {
+    int empty[CELLS];
+    int n = 0;
+    for (uint32_t bits = ~(mover | other) & FULL; bits; bits &= bits - 1) empty[n++] = __builtin_ctz(bits);
+
+    uint32_t sides[2] = {mover, other};
+    int remaining = FxFTTT_Solver::LAST_MOVE - popcount(mover | other);
+    for (int i = 0; i < remaining; ++i) {
+        int j = i + (int)(rng() % (n - i));
+        swap(empty[i], empty[j]);
+        sides[i & 1] |= 1u << empty[i];
+    }
+    int diff = FxFTTT_Solver::triples(sides[0]) - FxFTTT_Solver::triples(sides[1]);
+    return diff > 0 ? 1.0 : (diff < 0 ? 0.0 : 0.5);
+}
+
+int FxFTTT_MCTS::best_cell(uint32_t mover, uint32_t other, const SearchLimits& limits) {
+    playouts = 0;
+    if (popcount(mover | other) >= FxFTTT_Solver::LAST_MOVE) return -1;
+
+    // Carry on from the old tree if this is the old root plus one move each
+    bool reused = !nodes.empty() && mover == root_mover && other == root_other;
+    uint32_t ours = mover & ~root_mover, theirs = other & ~root_other;
+    if (!reused && !nodes.empty() && (root_mover & ~mover) == 0 && (root_other & ~other) == 0 &&
+        popcount(ours) == 1 && popcount(theirs) == 1) {
+        int after_ours = child_with(0, __builtin_ctz(ours));
+        int after_theirs = after_ours >= 0 ? child_with(after_ours, __builtin_ctz(theirs)) : -1;
+        if (after_theirs >= 0) {
+            reroot(after_theirs);
+            reused = true;
+        }
+    }
+    if (!reused) {
+        nodes.clear();
+        add_node(mover, other, -1);
+    }
+    root_mover = mover;
+    root_other = other;
+
+    long long max_playouts = limits.max_nodes;
+    if (max_playouts <= 0 && limits.max_seconds <= 0) max_playouts = 10000;
+    auto deadline = chrono::steady_clock::now() + chrono::duration<double>(limits.max_seconds);
+
+    int path[CELLS + 1];
+    do {
+        // Selection: UCB1 down the fully expanded nodes
+        uint32_t me = mover, opp = other;
+        int node = 0, depth = 0;
+        path[depth++] = node;
+        while (nodes[node].untried == 0 && nodes[node].first_child >= 0) {
+            double log_visits = log((double)nodes[node].visits);
+            int best = -1;
+            double best_value = -1;
+            for (int c = nodes[node].first_child; c >= 0; c = nodes[c].next_sibling) {
+                const Node& child = nodes[c];
+                double value = child.wins / child.visits + exploration * sqrt(log_visits / child.visits);
+                if (value > best_value) {
+                    best_value = value;
+                    best = c;
+                }
+            }
+            uint32_t moved = me | (1u << nodes[best].cell);
+            me = opp;
+            opp = moved;
+            node = best;
+            path[depth++] = node;
+        }
+
+        // Expansion: one random untried move
+        uint32_t untried = nodes[node].untried;
+        if (untried && (int)nodes.size() < MAX_NODES) {
+            for (int k = (int)(rng() % popcount(untried)); k > 0; --k) untried &= untried - 1;
+            int cell = __builtin_ctz(untried);
+            nodes[node].untried &= ~(1u << cell);
+            uint32_t moved = me | (1u << cell);
+            me = opp;
+            opp = moved;
+            int child = add_node(me, opp, cell);
+            nodes[child].next_sibling = nodes[node].first_child;
+            nodes[node].first_child = child;
+            path[depth++] = child;
+        }
+
+        // Simulation, then backpropagation: each node scores for the side that moved into it
+        double result = 1.0 - playout(me, opp);
+        for (int i = depth - 1; i >= 0; --i) {
+            nodes[path[i]].visits++;
+            nodes[path[i]].wins += (float)result;
+            result = 1.0 - result;
+        }
+        ++playouts;
+    } while ((max_playouts <= 0 || playouts < max_playouts) &&
+             (limits.max_seconds <= 0 || (playouts & 255) != 0 || chrono::steady_clock::now() < deadline));
+
+    int best = -1;
+    for (int c = nodes[0].first_child; c >= 0; c = nodes[c].next_sibling)
+        if (best < 0 || nodes[c].visits > nodes[best].visits) best = c;
+    return nodes[best].cell;
+}
@@ -0,0 +1,86 @@
+/**
+ * @file FiveXFiveTTTMCTS_Classes.h
+ * @brief Monte Carlo tree search player for 5x5 Tic-Tac-Toe.
+ *
+ * An anytime alternative to find_best_move(): instead of a fixed depth and
+ * a heuristic, it plays random games to the 24th move and grows a tree
+ * towards the moves that win them, for as long as it is given. Positions
+ * are FxFTTT_Solver masks (bit r * 5 + c).
+ */
+
+#ifndef FIVEXFIVETTTMCTS_CLASSES_H
+#define FIVEXFIVETTTMCTS_CLASSES_H
+
+#include "Search_Classes.h"
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using namespace std;
+
+/**
+ * @class FxFTTT_MCTS
+ * @brief UCT search with one node per visited position.
+ *
+ * Each iteration walks down the tree by UCB1, adds one untried move of the
+ * node it stops at, plays the rest of the game at random and credits the
+ * result (1 for a win, 1/2 for a draw) to every node on the way. Playouts
+ * run on two masks and a shuffled array of the empty cells, on the stack.
+ *
+ * The tree is kept between calls: when the next position is the old root
+ * after one move by each side, the search goes on from that grandchild's
+ * subtree instead of starting over.
+ */
+class FxFTTT_MCTS {
+public:
+    /**
+     * @param seed Seed of the playouts (same seed and budget, same moves).
+     * @param exploration UCB1 constant; larger explores more.
+     */
+    explicit FxFTTT_MCTS(unsigned seed = 0x5EED, double exploration = 1.0);
+
+    /**
+     * @brief Most visited cell (r * 5 + c) for the side owning `mover`
+     * against `other`, or -1 if the game is over.
+     * @param limits Stops after `max_nodes` playouts or `max_seconds`,
+     * whichever comes first (max_depth is ignored); a search with neither
+     * set runs 10000 playouts.
+     */
+    int best_cell(uint32_t mover, uint32_t other, const SearchLimits& limits);
+
+    /** @brief Playouts run by the last best_cell(), reused ones excluded. */
+    long long get_playouts() const { return playouts; }
+
+    /** @brief Visits of the root after the last best_cell(), reused ones included. */
+    long long get_root_visits() const;
+
+    /** @brief Drops the tree. */
+    void clear();
+
+private:
+    /** @brief A position; its statistics are for the side that moved into it. */
+    struct Node {
+        int first_child = -1;
+        int next_sibling = -1;
+        uint32_t untried = 0; ///< Empty cells without a child yet
+        int visits = 0;
+        float wins = 0;
+        signed char cell = -1; ///< Move leading here
+    };
+
+    /** @brief The tree stops growing (playouts go on) past this many nodes. */
+    static const int MAX_NODES = 1 << 21;
+
+    minstd_rand rng;
+    double exploration;
+    vector<Node> nodes;     ///< nodes[0] is the root
+    uint32_t root_mover = 0, root_other = 0;
+    long long playouts = 0;
+
+    int add_node(uint32_t mover, uint32_t other, int cell);
+    int child_with(int node, int cell) const;
+    void reroot(int node);
+    double playout(uint32_t mover, uint32_t other);
+};
+
+#endif // FIVEXFIVETTTMCTS_CLASSES_H
@@ -0,0 +1,221 @@
+/**
+ * @file FiveXFiveTTTSolver_Classes.cpp
+ * @brief Implementation of the exact 5x5 Tic-Tac-Toe solver.
+ */
+
+#include "FiveXFiveTTTSolver_Classes.h"
+#include <algorithm>
+
+using namespace std;
+
+namespace {
+
+const int N = 5;
+const int CELLS = FxFTTT_Solver::CELLS;
+const uint32_t FULL = (1u << CELLS) - 1;
+const int MAX_SCORE = 48; ///< Every segment on the board
+
+enum Bound { EXACT, LOWER, UPPER };
+
+/** @brief The 48 three-cell segments, and the ones through each cell. */
+struct Tables {
+    uint32_t segments[48];
+    uint32_t through[CELLS][12];
+    int n_through[CELLS] = {};
+    int centre_first[CELLS];          ///< Cells by distance from the centre
+    uint32_t row_image[8][N][1 << N]; ///< Image of a row's bits under each symmetry
+
+    Tables() {
+        static const int dirs[4][2] = {{0, 1}, {1, 0}, {1, 1}, {1, -1}};
+        int n = 0;
+        for (const auto& d : dirs)
+            for (int r = 0; r < N; ++r)
+                for (int c = 0; c < N; ++c) {
+                    int r_end = r + 2 * d[0], c_end = c + 2 * d[1];
+                    if (r_end < 0 || r_end >= N || c_end < 0 || c_end >= N) continue;
+                    uint32_t mask = 0;
+                    for (int k = 0; k < 3; ++k) mask |= 1u << ((r + k * d[0]) * N + (c + k * d[1]));
+                    for (int i = 0; i < CELLS; ++i)
+                        if (mask >> i & 1) through[i][n_through[i]++] = mask;
+                    segments[n++] = mask;
+                }
+
+        for (int i = 0; i < CELLS; ++i) centre_first[i] = i;
+        auto distance = [](int i) { return (i / N - N / 2) * (i / N - N / 2) + (i % N - N / 2) * (i % N - N / 2); };
+        stable_sort(centre_first, centre_first + CELLS, [&](int a, int b) { return distance(a) < distance(b); });
+
+        for (int t = 0; t < 8; ++t)
+            for (int r = 0; r < N; ++r)
+                for (int bits = 0; bits < (1 << N); ++bits) {
+                    uint32_t image = 0;
+                    for (int c = 0; c < N; ++c)
+                        if (bits >> c & 1) image |= 1u << FxFTTT_Solver::transform_cell(t, r * N + c);
+                    row_image[t][r][bits] = image;
+                }
+    }
+};
+
+const Tables tables;
+
+uint32_t apply(int t, uint32_t mask) {
+    uint32_t image = 0;
+    for (int r = 0; r < N; ++r) image |= tables.row_image[t][r][(mask >> (r * N)) & ((1u << N) - 1)];
+    return image;
+}
+
+uint64_t mix(uint64_t x) {
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+/** @brief Segments that `mover` completes by taking `cell`. */
+int completed_by(uint32_t mover, int cell) {
+    uint32_t after = mover | (1u << cell);
+    int n = 0;
+    for (int k = 0; k < tables.n_through[cell]; ++k) n += (after & tables.through[cell][k]) == tables.through[cell][k];
+    return n;
+}
+
+/** @brief Segments `mover` has not completed and `other` has not touched. */
+int open_segments(uint32_t mover, uint32_t other) {
+    int n = 0;
+    for (uint32_t s : tables.segments) n += (s & other) == 0 && (s & mover) != s;
+    return n;
+}
+
+} // namespace
+
+FxFTTT_Solver::FxFTTT_Solver(int table_bits) : table_bits(table_bits) {}
+
+void FxFTTT_Solver::clear() {
+    fill(table.begin(), table.end(), 0);
+}
+
+int FxFTTT_Solver::transform_cell(int t, int cell) {
+    int r = cell / N, c = cell % N;
+    if (t & 4) swap(r, c); // Transpose
+    if (t & 1) r = N - 1 - r;
+    if (t & 2) c = N - 1 - c;
+    return r * N + c;
+}
+
+int FxFTTT_Solver::triples(uint32_t mask) {
+    int n = 0;
+    for (uint32_t s : tables.segments) n += (mask & s) == s;
+    return n;
+}
+
+uint32_t FxFTTT_Solver::cells_of(const FxFTTT_board& board, char symbol) {
+    uint32_t mask = 0;
+    for (int i = 0; i < CELLS; ++i)
+        if (board.get_cell(i / N, i % N) == symbol) mask |= 1u << i;
+    return mask;
+}
+
+uint64_t FxFTTT_Solver::canonical(uint32_t mover, uint32_t other, int* symmetry) {
+    uint64_t best = 0;
+    for (int t = 0; t < 8; ++t) {
+        uint64_t key = apply(t, mover) | uint64_t(apply(t, other)) << CELLS;
+        if (t == 0 || key < best) {
+            best = key;
+            if (symmetry) *symmetry = t;
+        }
+    }
+    return best;
+}
+
+/**
+ * `diff` is the mover's three-in-a-row count minus the other side's so far.
+ * Fail-soft: a result outside (alpha, beta) is a bound on the true score.
+ */
+int FxFTTT_Solver::negamax(uint32_t mover, uint32_t other, int moves, int diff, int alpha, int beta) {
+    ++nodes;
+    if (moves == LAST_MOVE) return diff;
+
+    // Every open segment completed, or every one of the opponent's
+    int highest = diff + open_segments(mover, other);
+    int lowest = diff - open_segments(other, mover);
+    if (highest <= alpha) return highest;
+    if (lowest >= beta) return lowest;
+
+    uint64_t key = canonical(mover, other);
+    uint64_t& slot = table[mix(key) >> (64 - table_bits)];
+    if (slot && (slot >> 14) == key) {
+        int score = int(slot & 0x7F) - 64;
+        Bound bound = Bound((slot >> 7) & 3);
+        if (bound == EXACT) return score;
+        if (bound == LOWER) lowest = max(lowest, score);
+        else highest = min(highest, score);
+        if (lowest >= beta) return lowest;
+        if (highest <= alpha) return highest;
+    }
+    int alpha_start = alpha = max(alpha, lowest);
+    beta = min(beta, highest);
+
+    // Cells that complete our segments or break the opponent's first (insertion sort, stable)
+    int cells[CELLS], priority[CELLS];
+    int n = 0;
+    uint32_t empty = ~(mover | other) & FULL;
+    for (int cell : tables.centre_first) {
+        if (!(empty >> cell & 1)) continue;
+        int p = 0;
+        for (int k = 0; k < tables.n_through[cell]; ++k) {
+            uint32_t s = tables.through[cell][k];
+            if (!(s & other)) p += 1 << (2 * __builtin_popcount(s & mover));
+            if (!(s & mover)) p += 1 << (2 * __builtin_popcount(s & other));
+        }
+        int i = n++;
+        for (; i > 0 && priority[i - 1] < p; --i) {
+            cells[i] = cells[i - 1];
+            priority[i] = priority[i - 1];
+        }
+        cells[i] = cell;
+        priority[i] = p;
+    }
+
+    int best = -MAX_SCORE - 1;
+    for (int i = 0; i < n; ++i) {
+        int gained = completed_by(mover, cells[i]);
+        int score = -negamax(other, mover | (1u << cells[i]), moves + 1, -(diff + gained), -beta, -alpha);
+        if (score > best) {
+            best = score;
+            if (score > alpha) alpha = score;
+            if (alpha >= beta) break;
+        }
+    }
+
+    Bound bound = best <= alpha_start ? UPPER : (best >= beta ? LOWER : EXACT);
+    slot = key << 14 | uint64_t(bound) << 7 | uint64_t(best + 64);
+    return best;
+}
+
+int FxFTTT_Solver::solve(uint32_t mover, uint32_t other) {
+    int diff = triples(mover) - triples(other);
+    int moves = __builtin_popcount(mover | other);
+    if (moves >= LAST_MOVE) return diff;
+    if (table.empty()) table.assign(size_t(1) << table_bits, 0);
+    return negamax(mover, other, moves, diff, -MAX_SCORE - 1, MAX_SCORE + 1);
+}
+
+/**
+ * Once the score is known, each cell only needs a null-window test of
+ * whether it keeps that score.
+ */
+int FxFTTT_Solver::best_cell(uint32_t mover, uint32_t other, int* score) {
+    int value = solve(mover, other);
+    if (score) *score = value;
+    int moves = __builtin_popcount(mover | other);
+    if (moves >= LAST_MOVE) return -1;
+
+    int diff = triples(mover) - triples(other);
+    uint32_t empty = ~(mover | other) & FULL;
+    int fallback = -1;
+    for (int cell : tables.centre_first) {
+        if (!(empty >> cell & 1)) continue;
+        if (fallback < 0) fallback = cell;
+        int child_diff = -(diff + completed_by(mover, cell));
+        if (-negamax(other, mover | (1u << cell), moves + 1, child_diff, -value, -value + 1) >= value) return cell;
+    }
+    return fallback; // Not reached: some cell always keeps the score
+}
@@ -0,0 +1,90 @@
+/**
+ * @file FiveXFiveTTTSolver_Classes.h
+ * @brief Exact solver for 5x5 Tic-Tac-Toe positions.
+ *
+ * Where find_best_move() looks a few plies ahead and guesses from the
+ * three-in-a-row counts so far, the solver plays every line out to the
+ * 24th move and returns the final count difference under perfect play.
+ * Positions are two 25-bit masks, bit `r * 5 + c` for cell (r, c).
+ */
+
+#ifndef FIVEXFIVETTTSOLVER_CLASSES_H
+#define FIVEXFIVETTTSOLVER_CLASSES_H
+
+#include "FiveXFiveTTT_Classes.h"
+#include <cstdint>
+#include <vector>
+
+using namespace std;
+
+/**
+ * @class FxFTTT_Solver
+ * @brief Alpha-beta over the rest of the game, with a symmetry-reduced
+ * transposition table.
+ *
+ * A score is the side to move's three-in-a-row count minus the opponent's
+ * once the 24th move is played. Each node
+ * - stops early when the segments still open to either side cannot move
+ *   the score out of the window,
+ * - tries first the cells that complete or block the most segments,
+ * - keeps lower and upper bounds in a table keyed by the smallest of the
+ *   position's eight rotations and reflections.
+ */
+class FxFTTT_Solver {
+public:
+    /** @brief Cells of the board; the game ends with one of them empty. */
+    static const int CELLS = 25;
+
+    /** @brief Moves in a game. */
+    static const int LAST_MOVE = 24;
+
+    /**
+     * @brief Creates a solver with a table of 2^table_bits entries
+     * (8 bytes each; the default is 32 MB, allocated on the first solve).
+     */
+    explicit FxFTTT_Solver(int table_bits = 22);
+
+    /**
+     * @brief Final score difference for the side to move, which owns
+     * `mover`; the opponent owns `other`.
+     */
+    int solve(uint32_t mover, uint32_t other);
+
+    /**
+     * @brief A cell (r * 5 + c) that achieves solve()'s score, centre first on
+     * ties, or -1 if the game is over.
+     * @param score Optional, receives the score.
+     */
+    int best_cell(uint32_t mover, uint32_t other, int* score = nullptr);
+
+    /** @brief Masks of `symbol` ('X' or 'O') on `board`. */
+    static uint32_t cells_of(const FxFTTT_board& board, char symbol);
+
+    /**
+     * @brief Smallest image of the position under the board's symmetries,
+     * packed `mover | other << 25`.
+     * @param symmetry Optional, receives the symmetry (0-7) that gives it.
+     */
+    static uint64_t canonical(uint32_t mover, uint32_t other, int* symmetry = nullptr);
+
+    /** @brief Cell `cell` moved by symmetry `t`, as canonical() applies it. */
+    static int transform_cell(int t, int cell);
+
+    /** @brief Three-in-a-rows inside `mask`. */
+    static int triples(uint32_t mask);
+
+    /** @brief Positions visited by all solves so far. */
+    long long get_nodes() const { return nodes; }
+
+    /** @brief Forgets every stored position. */
+    void clear();
+
+private:
+    int table_bits;
+    vector<uint64_t> table; ///< key << 14 | bound << 7 | (score + 64), never 0 once written
+    long long nodes = 0;
+
+    int negamax(uint32_t mover, uint32_t other, int moves, int diff, int alpha, int beta);
+};
+
+#endif // FIVEXFIVETTTSOLVER_CLASSES_H
@@ -2,95 +2,119 @@
 // Created by Ali Tarek on 23/11/2025.
 ////--------------------------------------- IMPLEMENTATION
 #include "FiveXFiveTTT_Classes.h"
+#include "FiveXFiveTTTDatabase_Classes.h"
+#include "FiveXFiveTTTMCTS_Classes.h"
+#include "FiveXFiveTTTSolver_Classes.h"
 #include <iostream>
 #include <iomanip>
 #include <cctype>  // for toupper()
+#include <ctime>
+#include <algorithm>
 
+namespace {
 
+const int N = 5;
+const int CELLS = N * N;
+const int SYMMETRIES = 8;
 
-FxFTTT_board :: FxFTTT_board() : Board(5, 5) {
-  for (auto& row : board){
-    for (auto& cell : row){
-      cell = blank_symbol;
-    }
-  }
+/** @brief Cell index that cell (r, c) moves to under symmetry `t`. */
+int transform(int t, int r, int c) {
+  if (t & 4) std::swap(r, c); // Transpose
+  if (t & 1) r = N - 1 - r;   // Flip rows
+  if (t & 2) c = N - 1 - c;   // Flip columns
+  return r * N + c;
 }
 
-
-bool FxFTTT_board::update_board(Move<char>* move) {
-  int x = move->get_x();
-  int y = move->get_y();
-  char mark = move->get_symbol();
-
-
-  if (x >= 0 && x < rows && y >= 0 && y < columns && board[x][y] == blank_symbol) {
-    n_moves++;
-    board[x][y] = toupper(mark);
-    return true;
+/** @brief image[t][i]: where cell i goes under t; source[t][i]: the cell that goes to i. */
+struct SymmetryTables {
+  int image[SYMMETRIES][CELLS];
+  int source[SYMMETRIES][CELLS];
+  int centre_first[CELLS]; ///< Cells by distance from the centre, which no symmetry changes
+  uint64_t keys[CELLS][2]; ///< Zobrist keys of X and O on each cell
+
+  SymmetryTables() {
+    for (int i = 0; i < CELLS; ++i) centre_first[i] = i;
+    auto distance = [](int i) { return (i / N - N / 2) * (i / N - N / 2) + (i % N - N / 2) * (i % N - N / 2); };
+    std::stable_sort(centre_first, centre_first + CELLS, [&](int a, int b) { return distance(a) < distance(b); });
+
+    for (int t = 0; t < SYMMETRIES; ++t)
+      for (int i = 0; i < CELLS; ++i) {
+        image[t][i] = transform(t, i / N, i % N);
+        source[t][image[t][i]] = i;
+      }
+    uint64_t z = 0x5EED5EED5EED5EEDull;
+    for (auto& cell : keys)
+      for (uint64_t& k : cell) {
+        z += 0x9E3779B97F4A7C15ull; // SplitMix64
+        uint64_t x = z;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+        k = x ^ (x >> 31);
+      }
   }
-  return false;
-}
-
-  int FxFTTT_board :: check_all_lines(){
-
-    int sum_x=0, sum_o=0;
-
-
-    auto all_equal = [&](char a, char b, char c) {
-    return a == b && b == c && a != blank_symbol;
-
-    };
+};
+
+const SymmetryTables symmetry;
+
+const int SEGMENTS = 48;         ///< Three-cell lines: 15 rows, 15 columns, 9 + 9 diagonals
+const int MAX_SEGMENTS_THROUGH = 12;
+
+/** @brief The three-in-a-row segments of the board and those through each cell. */
+struct SegmentTables {
+  int through[CELLS][MAX_SEGMENTS_THROUGH];
+  int n_through[CELLS] = {};
+
+  SegmentTables() {
+    static const int dirs[4][2] = {{0, 1}, {1, 0}, {1, 1}, {1, -1}};
+    int id = 0;
+    for (const auto& d : dirs)
+      for (int r = 0; r < N; ++r)
+        for (int c = 0; c < N; ++c) {
+          int r_end = r + 2 * d[0], c_end = c + 2 * d[1];
+          if (r_end < 0 || r_end >= N || c_end < 0 || c_end >= N) continue;
+          for (int k = 0; k < 3; ++k) {
+            int i = (r + k * d[0]) * N + (c + k * d[1]);
+            through[i][n_through[i]++] = id;
+          }
+          ++id;
+        }
+  }
+};
 
-    //check rows
-  for(int i=0;i<rows;i++){
+const SegmentTables segments;
 
-    for(int j=0;j+2<columns;j++){
+} // namespace
 
 
 
-      if(all_equal(board[i][j], board[i][j+1], board[i][j+2] )){
+FxFTTT_board :: FxFTTT_board() : Board(5, 5), database(&FxFTTT_Database::shared()) {
+  fill_cells(blank_symbol);
+}
 
-        if ( board[i][j]== 'X'){sum_x++;}
 
-        else if ( board[i][j] == 'O' ){sum_o++;}
-      }
-    }
+FxFTTT_board::~FxFTTT_board() {
+  delete solver;
 }
-  //check columns
-  for(int j=0;j<columns;j++){
 
-    for(int i=0;i+2<rows;i++){
 
+bool FxFTTT_board::update_board(Move<char>* move) {
+  int x = move->get_x();
+  int y = move->get_y();
+  char mark = move->get_symbol();
 
 
-      if(all_equal(board[i][j], board[i+1][j], board[i+2][j] )){
-        if ( board[i][j] == 'X'){sum_x++;}
-        else if ( board[i][j] == 'O' ){sum_o++;}
-      }
-     }
-    }
+  if (x >= 0 && x < rows && y >= 0 && y < columns && cell(x, y) == blank_symbol) {
+    n_moves++;
+    place(x, y, toupper(mark));
+    record_move(x, y);
+    return true;
+  }
+  return false;
+}
 
-  //check main diagonal
- for (int i=0;i+2<rows;i++){
-   for (int j=0;j+2<columns;j++){
-     if(all_equal(board[i][j], board[i+1][j+1], board[i+2][j+2] )){
-       if ( board[i][j] == 'X'){sum_x++;}
-       else if ( board[i][j] == 'O' ){sum_o++;}
-     }
-   }
- }
- //check anti diagonal
- for (int j=columns-1;j-2>=0;j--){
-   for (int i=0;i+2<rows;i++){
-     if(all_equal(board[i][j], board[i+1][j-1], board[i+2][j-2] )){
-       if ( board[i][j] == 'X'){sum_x++;}
-       else if ( board[i][j] == 'O' ){sum_o++;}
-     }
-   }
- }
-if (sum_x==sum_o) {return 0;}
-if (sum_x>sum_o) {return 1;}
-if (sum_x<sum_o) {return -1;}
+int FxFTTT_board::check_all_lines() {
+  if (triples[0] == triples[1]) return 0;
+  return (triples[0] > triples[1]) ? 1 : -1;
 }
 
 
@@ -137,9 +161,57 @@ bool FxFTTT_board :: is_lose(Player<char>*player) {
 }
 
 
+Outcome FxFTTT_board::evaluate_last_move(Player<char>* player) {
+  // The lines are only counted once, when the 24th move is played
+  if (n_moves < 24)
+    return Outcome::ONGOING;
+
+  int result = check_all_lines();
+  if (result == 0)
+    return Outcome::DRAW;
+
+  bool x_ahead = (result == 1);
+  return (x_ahead == (player->get_symbol() == 'X')) ? Outcome::WIN : Outcome::LOSE;
+}
+
+
 FxFTTT_ui ::FxFTTT_ui() : UI<char>("Welcome to 5x5 tic tac toe by Ali",3) {}
 
 
+FxFTTT_ui::~FxFTTT_ui() {
+  delete mcts[0];
+  delete mcts[1];
+}
+
+
+Player<char>** FxFTTT_ui::setup_players() {
+  Player<char>** players = new Player<char>*[2];
+  vector<string> type_options = { "Human", "Computer", "Computer (Monte Carlo)" };
+
+  string nameX = get_player_name("Player X");
+  PlayerType typeX = get_player_type_choice("Player X", type_options);
+  players[0] = create_player(nameX, 'X', typeX);
+
+  string nameO = get_player_name("Player O");
+  PlayerType typeO = get_player_type_choice("Player O", type_options);
+  players[1] = create_player(nameO, 'O', typeO);
+
+  return players;
+}
+
+
+PlayerType FxFTTT_ui::get_player_type_choice(string player_label, const vector<string>& options) {
+  cout << "Choose " << player_label << " type:\n";
+  for (size_t i = 0; i < options.size(); ++i)
+    cout << i + 1 << ". " << options[i] << "\n";
+  int choice;
+  cin >> choice;
+  if (choice == 2) return PlayerType::COMPUTER;
+  if (choice == 3) return PlayerType::AI;
+  return PlayerType::HUMAN;
+}
+
+
 Player<char>* FxFTTT_ui::create_player(string& name, char symbol, PlayerType type ) {
   cout << "Creating " << (type == PlayerType::HUMAN ? "human" : "computer")
        << " player: " << name << " (" << symbol << ")\n";
@@ -173,7 +245,21 @@ Move<char>* FxFTTT_ui::get_move(Player<char>* player) {
             x = rand() % player->get_board_ptr()->get_rows();
             y = rand() % player->get_board_ptr()->get_columns();
         }
+        else if (player->get_type() == PlayerType::AI) {
+            char sym = player->get_symbol();
+            FxFTTT_MCTS*& engine = mcts[sym == 'X' ? 0 : 1];
+            if (!engine) engine = new FxFTTT_MCTS((unsigned)time(nullptr));
+            SearchLimits limits;
+            limits.max_seconds = mcts_seconds;
+            int cell = engine->best_cell(FxFTTT_Solver::cells_of(*board, sym),
+                                         FxFTTT_Solver::cells_of(*board, sym == 'X' ? 'O' : 'X'), limits);
+            x = cell / 5;
+            y = cell % 5;
+            cout << "\nAI chooses move: " << x << y << " (" << engine->get_root_visits() << " playouts)" << endl;
+        }
         else {
+            char sym = player->get_symbol();
+            board->set_ai_symbols(sym, sym == 'X' ? 'O' : 'X');
             std::pair<int,int> best_move = board->find_best_move();
             x = best_move.first;
             y = best_move.second;
@@ -181,7 +267,7 @@ Move<char>* FxFTTT_ui::get_move(Player<char>* player) {
         }
     }
 
-    return new Move<char>(x, y, player->get_symbol());
+    return move_slot.emplace(x, y, player->get_symbol());
 }
 
 
@@ -194,167 +280,156 @@ bool FxFTTT_board::game_is_over(Player<char>* player) {
 
 //Ai functions
 
-std::vector<std::pair<int, int> > FxFTTT_board::get_available_moves() {
-     vector<std::pair<int, int> > moves;
-  for (int i=0 ; i<rows ;i++) {
-         for (int j=0 ; j<columns ; j++) {
-           if (board[i][j] == blank_symbol) {
-                moves.push_back(std::make_pair(i,j));
-           }
-         }
-       }
-  return moves;
+int FxFTTT_board::generate_moves(char symbol, MoveList<char>& moves) const {
+  return generate_placements(blank_symbol, symbol, moves);
 }
 
 
 
 void FxFTTT_board::simulate_move( int row, int col, char symbol) {
-  board[row][col] = symbol;
+  place(row, col, symbol);
   n_moves++;
 }
 
 
 void FxFTTT_board::undo_move(int row, int col) {
-  board[row][col] = blank_symbol;
+  place(row, col, blank_symbol);
   n_moves--;
 }
 
 
-
-void FxFTTT_board::set_ai_symbols(char ai, char opp) {
-    ai_symbol = ai;
-    opp_symbol = opp;
+int FxFTTT_board::side_index(char symbol) {
+  return symbol == 'X' ? 0 : (symbol == 'O' ? 1 : -1);
 }
 
 
+void FxFTTT_board::place(int row, int col, char symbol) {
+  // Only X and O have keys and counts, so the empty board hashes to 0 in every orientation
+  int i = row * columns + col;
+  int old_side = side_index(cell(row, col));
+  int new_side = side_index(symbol);
+  if (old_side >= 0) {
+    for (int t = 0; t < SYMMETRIES; ++t)
+      symmetric_hash[t] ^= symmetry.keys[symmetry.image[t][i]][old_side];
+    for (int k = 0; k < segments.n_through[i]; ++k)
+      if (segment_count[segments.through[i][k]][old_side]-- == 3) triples[old_side]--;
+  }
+  if (new_side >= 0) {
+    for (int t = 0; t < SYMMETRIES; ++t)
+      symmetric_hash[t] ^= symmetry.keys[symmetry.image[t][i]][new_side];
+    for (int k = 0; k < segments.n_through[i]; ++k)
+      if (++segment_count[segments.through[i][k]][new_side] == 3) triples[new_side]++;
+  }
+  set_cell(row, col, symbol);
+}
 
 
-//heuristic function
+int FxFTTT_board::canonical_symmetry() const {
+  int best = 0;
+  for (int t = 1; t < SYMMETRIES; ++t)
+    if (symmetric_hash[t] < symmetric_hash[best]) best = t;
+  return best;
+}
 
-int FxFTTT_board::evaluate_board() {
+
+uint64_t FxFTTT_board::get_canonical_hash() const {
+  return symmetric_hash[canonical_symmetry()];
+}
 
 
-    int ai_score = 0, opp_score = 0;
+int FxFTTT_board::generate_canonical_moves(char symbol, MoveList<char>& moves) const {
+  const int* source = symmetry.source[canonical_symmetry()];
+  moves.clear();
+  for (int i : symmetry.centre_first) {
+    int r = source[i] / columns, c = source[i] % columns;
+    if (cell(r, c) == blank_symbol) moves.add(r, c, symbol);
+  }
+  return moves.size();
+}
 
 
 
-    auto all_equal = [&](char a, char b, char c) {
-        return a == b && b == c && a != blank_symbol;
-    };
+void FxFTTT_board::set_ai_symbols(char ai, char opp) {
+    ai_symbol = ai;
+    opp_symbol = opp;
+}
 
 
 
-    // Check rows
-    for (int i = 0; i < rows; i++) {
-        for (int j = 0; j + 2 < columns; j++) {
-            char c = board[i][j];
-            if (all_equal(c, board[i][j+1], board[i][j+2])) {
-                if (c == ai_symbol) ai_score++;
-                else if (c == opp_symbol) opp_score++;
-            }
-        }
-    }
 
+//heuristic function
 
+int FxFTTT_board::evaluate_board() {
+  return triples_of(ai_symbol) - triples_of(opp_symbol);
+}
 
-    // Check columns
-    for (int j = 0; j < columns; j++) {
-        for (int i = 0; i + 2 < rows; i++) {
-            char c = board[i][j];
-            if (all_equal(c, board[i+1][j], board[i+2][j])) {
-                if (c == ai_symbol) ai_score++;
-                else if (c == opp_symbol) opp_score++;
-            }
-        }
-    }
 
+int FxFTTT_board::triples_of(char symbol) const {
+  int side = side_index(symbol);
+  return side < 0 ? 0 : triples[side];
+}
 
 
-    // Check main diagonals
-    for (int i = 0; i + 2 < rows; i++) {
-        for (int j = 0; j + 2 < columns; j++) {
-            char c = board[i][j];
-            if (all_equal(c, board[i+1][j+1], board[i+2][j+2])) {
-                if (c == ai_symbol) ai_score++;
-                else if (c == opp_symbol) opp_score++;
-            }
-        }
-    }
 
 
 
-    // Check anti-diagonals
-    for (int i = 0; i + 2 < rows; i++) {
-        for (int j = 2; j < columns; j++) {
-            char c = board[i][j];
-            if (all_equal(c, board[i+1][j-1], board[i+2][j-2])) {
-                if (c == ai_symbol) ai_score++;
-                else if (c == opp_symbol) opp_score++;
-            }
-        }
+std::pair<int,int> FxFTTT_board::find_best_move() {
+    if (n_moves >= 24) return {-1, -1};
+
+    uint32_t mine = FxFTTT_Solver::cells_of(*this, ai_symbol);
+    uint32_t theirs = FxFTTT_Solver::cells_of(*this, opp_symbol);
+    int cell;
+    if (database && database->lookup(mine, theirs, cell))
+        return {cell / columns, cell % columns};
+    if (n_moves >= SOLVE_FROM_MOVE) {
+        if (!solver) solver = new FxFTTT_Solver(20);
+        cell = solver->best_cell(mine, theirs);
+        return {cell / columns, cell % columns};
     }
 
-    return ai_score - opp_score;
+    FxFTTT_Position pos(this, ai_symbol, opp_symbol);
+    SearchResult<char> result = search.search(pos, 9);
+    if (!result.found) return {-1, -1};
+    return {result.best.get_x(), result.best.get_y()};
 }
 
 
+// --- FxFTTT_Position ---
 
+FxFTTT_Position::FxFTTT_Position(FxFTTT_board* board, char ai, char opp)
+    : board(board), ai(ai), opp(opp), side(ai) {}
 
+int FxFTTT_Position::generate_moves(MoveList<char>& moves) const {
+    // The game stops after 24 moves, with one cell still empty
+    if (board->get_n_moves() >= 24) { moves.clear(); return 0; }
+    return board->generate_canonical_moves(side, moves);
+}
 
-// --- Minimax function with depth limit 7 ---
-
-
-int FxFTTT_board::minimax(int depth, bool is_max, int alpha, int beta) {
-
-    auto moves = get_available_moves();
-
-    // Stop if no moves left or depth limit reached
-    if (depth == 0 || moves.empty()) {
-        return evaluate_board();
-    }
+void FxFTTT_Position::make_move(const Move<char>& move) {
+    board->simulate_move(move.get_x(), move.get_y(), side);
+    side = (side == ai) ? opp : ai;
+}
 
-    if (is_max) {
-        int best = -100000;
-        for (auto& move : moves) {
-            simulate_move(move.first, move.second, ai_symbol);
-            int val = minimax(depth - 1, false, alpha, beta);
-            undo_move(move.first, move.second);
-            best = std::max(best, val);
-            alpha = std::max(alpha, best);
-            if (beta <= alpha) break;
-        }
-        return best;
-    } else {
-        int best = 100000;
-        for (auto& move : moves) {
-            simulate_move(move.first, move.second, opp_symbol);
-            int val = minimax(depth - 1, true, alpha, beta);
-            undo_move(move.first, move.second);
-            best = std::min(best, val);
-            beta = std::min(beta, best);
-            if (beta <= alpha) break;
-        }
-        return best;
-    }
+void FxFTTT_Position::undo_move(const Move<char>& move) {
+    board->undo_move(move.get_x(), move.get_y());
+    side = (side == ai) ? opp : ai;
 }
 
+Outcome FxFTTT_Position::last_move_outcome() const {
+    if (board->get_n_moves() < 24) return Outcome::ONGOING;
+    // `side` is the player to reply, so the mover is the other one
+    int diff = board->evaluate_board();
+    if (side == ai) diff = -diff;
+    if (diff > 0) return Outcome::WIN;
+    if (diff < 0) return Outcome::LOSE;
+    return Outcome::DRAW;
+}
 
-std::pair<int,int> FxFTTT_board::find_best_move() {
-    int best_val = -100000;
-    std::pair<int,int> best_move = {-1,-1};
-    int alpha = -100000;
-    int beta = 100000;
-    for (auto& move : get_available_moves()) {
-        simulate_move(move.first, move.second, ai_symbol);
-        int move_val = minimax(7, false, alpha, beta);
-        undo_move(move.first, move.second);
-
-        if (move_val > best_val) {
-            best_val = move_val;
-            best_move = move;
-            alpha = std::max(alpha, best_val);
-        }
-    }
+int FxFTTT_Position::evaluate() const {
+    int score = board->evaluate_board();
+    return side == ai ? score : -score;
+}
 
-    return best_move;
+uint64_t FxFTTT_Position::key() const {
+    return board->get_canonical_hash() ^ search_side_key(side);
 }
\ No newline at end of file
@@ -10,8 +10,49 @@
 #define FIVEXFIVETTT_CLASSES_H
 
 #include "BoardGame_Classes.h"
+#include "Search_Classes.h"
 using namespace std;
 
+class FxFTTT_board;
+class FxFTTT_Database;
+class FxFTTT_MCTS;
+class FxFTTT_Solver;
+
+/**
+ * @class FxFTTT_Position
+ * @brief Search view of an FxFTTT_board for AlphaBetaSearch.
+ *
+ * The 24th move ends the game and is scored by the line counts; earlier
+ * leaves use evaluate_board() for the searching side.
+ *
+ * Keys are the board's symmetry-reduced hash, so the eight rotations and
+ * reflections of a position share one table entry. Moves are listed in
+ * an order fixed by the canonical orientation, so a stored move index
+ * names the same cell, up to symmetry, in every orientation.
+ */
+class FxFTTT_Position {
+public:
+    typedef char Symbol;
+
+    /**
+     * @brief Starts a search on `board` with `ai` to move against `opp`.
+     */
+    FxFTTT_Position(FxFTTT_board* board, char ai, char opp);
+
+    int generate_moves(MoveList<char>& moves) const;
+    void make_move(const Move<char>& move);
+    void undo_move(const Move<char>& move);
+    Outcome last_move_outcome() const;
+    int evaluate() const;
+    uint64_t key() const;
+
+private:
+    FxFTTT_board* board;
+    char ai;   ///< Side the search runs for.
+    char opp;  ///< The other side.
+    char side; ///< Side to move.
+};
+
 /**
  * @class FxFTTT_board
  * @brief Represents the 5x5 Tic-Tac-Toe board logic.
@@ -21,6 +62,25 @@ private :
     char blank_symbol = '.';
     char ai_symbol = 'X';
     char opp_symbol = 'O';
+    AlphaBetaSearch<FxFTTT_Position> search; ///< Engine behind find_best_move().
+    const FxFTTT_Database* database;  ///< Consulted before anything else; may be null.
+    FxFTTT_Solver* solver = nullptr;  ///< Endgame solver, created on first use.
+    uint64_t symmetric_hash[8] = {}; ///< Hash of the board under each rotation/reflection
+    unsigned char segment_count[48][2] = {}; ///< X and O discs in each three-cell segment
+    int triples[2] = {};             ///< Segments full of X, and full of O
+
+    /**
+     * @brief Writes a cell through set_cell(), keeping symmetric_hash,
+     * segment_count and triples up to date (the 12 segments at most
+     * through the cell).
+     */
+    void place(int row, int col, char symbol);
+
+    /** @brief 0 for X, 1 for O, -1 for anything else. */
+    static int side_index(char symbol);
+
+    /** @brief Symmetry whose image of the board has the smallest hash. */
+    int canonical_symmetry() const;
 
 public :
     /**
@@ -28,6 +88,11 @@ public :
      */
     FxFTTT_board();
 
+    ~FxFTTT_board();
+
+    /** @brief Moves played from which find_best_move() solves exactly. */
+    static const int SOLVE_FROM_MOVE = 10;
+
     /**
      * @brief Updates the board with a move.
      * @param move Pointer to the Move object.
@@ -64,11 +129,37 @@ public :
     bool game_is_over(Player<char> *) override;
 
     /**
-     * @brief Counts the total 3-in-a-row patterns for both X and O.
+     * @brief Ongoing until the 24th move, then compares the three-in-a-row counts.
+     */
+    Outcome evaluate_last_move(Player<char>* player) override;
+
+    /**
+     * @brief Every empty cell.
+     */
+    int generate_moves(char symbol, MoveList<char>& moves) const override;
+
+    /**
+     * @brief Every empty cell, centre first, ties going by where the cell
+     * lands in the canonical orientation (see get_canonical_hash()).
+     */
+    int generate_canonical_moves(char symbol, MoveList<char>& moves) const;
+
+    /**
+     * @brief Hash shared by the board and its 7 rotations and reflections:
+     * the smallest of their hashes.
+     */
+    uint64_t get_canonical_hash() const;
+
+    /**
+     * @brief Compares the 3-in-a-row counts of X and O, kept up to date by
+     * every move, so this is O(1).
      * @return 1 if X > O, -1 if O > X, 0 if equal.
      */
     int check_all_lines();
 
+    /** @brief Number of 3-in-a-row patterns of `symbol` on the board. */
+    int triples_of(char symbol) const;
+
     // --- AI functions ---
 
     /**
@@ -82,32 +173,27 @@ public :
     void undo_move( int row, int col);
 
     /**
-     * @brief Gets all available empty spots.
-     * @return Vector of coordinates.
+     * @brief Evaluates the current board state in O(1).
+     * @return The AI's 3-in-a-row count minus the opponent's.
      */
-    std::vector<std::pair<int,int>> get_available_moves();
+    int evaluate_board();
 
     /**
-     * @brief Minimax algorithm for 5x5 board optimization.
-     * @param depth Search depth.
-     * @param is_max Maximizing or minimizing player.
-     * @param alpha Alpha value for pruning.
-     * @param beta Beta value for pruning.
-     * @return Heuristic score.
+     * @brief Finds the best move for the AI: from the solved-positions
+     * database if it has the position, by an exact solve once
+     * SOLVE_FROM_MOVE moves are played, else with a 9-ply alpha-beta search.
+     * @return Pair of integers (row, col), or (-1, -1) if the game is over.
      */
-    int minimax(int depth, bool is_max, int alpha, int beta);
+    std::pair<int,int> find_best_move();
 
     /**
-     * @brief Evaluates the current board state.
-     * @return Score based on 3-in-a-row counts.
+     * @brief Sets the database find_best_move() consults (nullptr for
+     * none). Boards start with FxFTTT_Database::shared().
      */
-    int evaluate_board();
+    void set_database(const FxFTTT_Database* new_database) { database = new_database; }
 
-    /**
-     * @brief Finds the best move for the AI.
-     * @return Pair of integers (row, col).
-     */
-    std::pair<int,int> find_best_move();
+    /** @brief Positions visited by all searches of this board so far. */
+    long long get_search_nodes() const { return search.nodes_searched(); }
 
     void set_ai_symbols(char ai, char opp);
 };
@@ -115,11 +201,32 @@ public :
 /**
  * @class FxFTTT_ui
  * @brief UI for 5x5 Tic-Tac-Toe.
+ *
+ * Offers two computer players: find_best_move(), and a Monte Carlo tree
+ * search (PlayerType::AI) that thinks for `mcts_seconds` per move and
+ * keeps its tree from one move to the next.
  */
 class FxFTTT_ui : public UI<char> {
+    FxFTTT_MCTS* mcts[2] = {};  ///< Per side, created on its first move
+    double mcts_seconds = 1.0;
+
+protected:
+    /**
+     * @brief Reads a choice among `options`: 2 is the search computer,
+     * 3 the Monte Carlo one, anything else a human.
+     */
+    PlayerType get_player_type_choice(string player_label, const vector<string>& options) override;
+
 public :
     FxFTTT_ui();
 
+    ~FxFTTT_ui();
+
+    /**
+     * @brief Asks for both players, offering both computer players.
+     */
+    Player<char>** setup_players() override;
+
     /**
      * @brief Creates a player.
      */
@@ -12,30 +12,29 @@ FourByFour_Board::FourByFour_Board() : Board(4, 4) {
     // Start with an empty board
     for (int r = 0; r < rows; ++r)
         for (int c = 0; c < columns; ++c)
-            board[r][c] = '.';
+            set_cell(r, c, '.');
 
     // Initial layout:
     // Row 0: O X O X
-    board[0][0] = 'O';
-    board[0][1] = 'X';
-    board[0][2] = 'O';
-    board[0][3] = 'X';
+    set_cell(0, 0, 'O');
+    set_cell(0, 1, 'X');
+    set_cell(0, 2, 'O');
+    set_cell(0, 3, 'X');
 
     // Row 3: X O X O
-    board[3][0] = 'X';
-    board[3][1] = 'O';
-    board[3][2] = 'X';
-    board[3][3] = 'O';
+    set_cell(3, 0, 'X');
+    set_cell(3, 1, 'O');
+    set_cell(3, 2, 'X');
+    set_cell(3, 3, 'O');
 }
 
 bool FourByFour_Board::update_board(Move<char> *move) {
-    FourByFour_Move *m = static_cast<FourByFour_Move *>(move);
-
-    int fr = m->get_from_r();
-    int fc = m->get_from_c();
-    int tr = m->get_to_r();
-    int tc = m->get_to_c();
-    char symbol = m->get_symbol();
+    // Any Move<char> carrying a source works, not only FourByFour_Move
+    int fr = move->get_from_x();
+    int fc = move->get_from_y();
+    int tr = move->get_x();
+    int tc = move->get_y();
+    char symbol = move->get_symbol();
 
     // 1) Bounds check
     if (fr < 0 || fr >= 4 || fc < 0 || fc >= 4) {
@@ -48,8 +47,8 @@ bool FourByFour_Board::update_board(Move<char> *move) {
     }
 
     // 2) Source must contain player's symbol
-    if (board[fr][fc] != symbol) {
-        if (board[fr][fc] == '.') {
+    if (cell(fr, fc) != symbol) {
+        if (cell(fr, fc) == '.') {
             cout << "Invalid move: source cell is empty.\n";
         } else {
             cout << "Invalid move: source cell does not contain your token.\n";
@@ -58,7 +57,7 @@ bool FourByFour_Board::update_board(Move<char> *move) {
     }
 
     // 3) Destination must be empty
-    if (board[tr][tc] != '.') {
+    if (cell(tr, tc) != '.') {
         cout << "Invalid move: destination cell is not empty.\n";
         return false;
     }
@@ -82,10 +81,11 @@ bool FourByFour_Board::update_board(Move<char> *move) {
     }
 
     // 5) Apply the move
-    board[tr][tc] = board[fr][fc];
-    board[fr][fc] = '.';
+    set_cell(tr, tc, cell(fr, fc));
+    set_cell(fr, fc, '.');
 
     n_moves++;
+    record_move(tr, tc);
     return true;
 }
 
@@ -93,9 +93,9 @@ bool FourByFour_Board::check_win_for_symbol(char s) {
     // Horizontal 3 in a row
     for (int r = 0; r < 4; ++r) {
         for (int c = 0; c <= 4 - 3; ++c) {
-            if (board[r][c] == s &&
-                board[r][c + 1] == s &&
-                board[r][c + 2] == s)
+            if (cell(r, c) == s &&
+                cell(r, c + 1) == s &&
+                cell(r, c + 2) == s)
                 return true;
         }
     }
@@ -103,24 +103,24 @@ bool FourByFour_Board::check_win_for_symbol(char s) {
     // Vertical 3 in a column
     for (int c = 0; c < 4; ++c) {
         for (int r = 0; r <= 4 - 3; ++r) {
-            if (board[r][c] == s &&
-                board[r + 1][c] == s &&
-                board[r + 2][c] == s)
+            if (cell(r, c) == s &&
+                cell(r + 1, c) == s &&
+                cell(r + 2, c) == s)
                 return true;
         }
     }
 
     // Main diagonal direction (3-length)
-    if (board[0][0] == s && board[1][1] == s && board[2][2] == s) return true;
-    if (board[1][1] == s && board[2][2] == s && board[3][3] == s) return true;
-    if (board[0][1] == s && board[1][2] == s && board[2][3] == s) return true;
-    if (board[1][0] == s && board[2][1] == s && board[3][2] == s) return true;
+    if (cell(0, 0) == s && cell(1, 1) == s && cell(2, 2) == s) return true;
+    if (cell(1, 1) == s && cell(2, 2) == s && cell(3, 3) == s) return true;
+    if (cell(0, 1) == s && cell(1, 2) == s && cell(2, 3) == s) return true;
+    if (cell(1, 0) == s && cell(2, 1) == s && cell(3, 2) == s) return true;
 
     // Anti-diagonal direction
-    if (board[0][3] == s && board[1][2] == s && board[2][1] == s) return true;
-    if (board[1][2] == s && board[2][1] == s && board[3][0] == s) return true;
-    if (board[0][2] == s && board[1][1] == s && board[2][0] == s) return true;
-    if (board[1][3] == s && board[2][2] == s && board[3][1] == s) return true;
+    if (cell(0, 3) == s && cell(1, 2) == s && cell(2, 1) == s) return true;
+    if (cell(1, 2) == s && cell(2, 1) == s && cell(3, 0) == s) return true;
+    if (cell(0, 2) == s && cell(1, 1) == s && cell(2, 0) == s) return true;
+    if (cell(1, 3) == s && cell(2, 2) == s && cell(3, 1) == s) return true;
 
     return false;
 }
@@ -142,8 +142,16 @@ bool FourByFour_Board::game_is_over(Player<char> *player) {
     return is_win(player) || is_draw(player);
 }
 
-vector<FourByFour_Move> FourByFour_Board::get_valid_moves(char symbol) {
-    vector<FourByFour_Move> moves;
+Outcome FourByFour_Board::evaluate_last_move(Player<char> *player) {
+    // Only the token that just moved can complete a new line
+    if (cell(last_x, last_y) == player->get_symbol() && has_line_through(last_x, last_y, 3))
+        return Outcome::WIN;
+    if (n_moves > 250) return Outcome::DRAW;
+    return Outcome::ONGOING;
+}
+
+int FourByFour_Board::generate_moves(char symbol, MoveList<char> &moves) const {
+    moves.clear();
 
     // Directions: up, down, left, right
     int dr[4] = {-1, 1, 0, 0};
@@ -151,7 +159,7 @@ vector<FourByFour_Move> FourByFour_Board::get_valid_moves(char symbol) {
 
     for (int r = 0; r < 4; ++r) {
         for (int c = 0; c < 4; ++c) {
-            if (board[r][c] != symbol) continue;
+            if (cell(r, c) != symbol) continue;
 
             for (int k = 0; k < 4; ++k) {
                 int nr = r + dr[k];
@@ -161,14 +169,14 @@ vector<FourByFour_Move> FourByFour_Board::get_valid_moves(char symbol) {
                 if (nr < 0 || nr >= 4 || nc < 0 || nc >= 4) continue;
 
                 // Must be empty destination
-                if (board[nr][nc] == '.') {
-                    moves.emplace_back(r, c, nr, nc, symbol);
+                if (cell(nr, nc) == '.') {
+                    moves.add(Move<char>(r, c, nr, nc, symbol));
                 }
             }
         }
     }
 
-    return moves;
+    return moves.size();
 }
 
 int FourByFour_Board::calc_heuristic_value(char ai_symbol, char opp_symbol) {
@@ -180,116 +188,60 @@ int FourByFour_Board::calc_heuristic_value(char ai_symbol, char opp_symbol) {
     return score;
 }
 
+FourByFour_Move FourByFour_Board::find_best_move(char ai, int depth) {
+    FourByFour_Position pos(this, ai);
+    SearchResult<char> result = search.search(pos, depth);
+    if (!result.found) return FourByFour_Move(0, 0, 0, 0, ai);
+    return FourByFour_Move(result.best);
+}
+
 // ---------------------------------------
-// FourByFour_UI Implementation
+// FourByFour_Position Implementation
 // ---------------------------------------
 
-FourByFour_UI::FourByFour_UI(FourByFour_Board *board)
-    : UI<char>("Welcome to 4x4 Tic-Tac-Toe! Move your pieces to align 3.", 3),
-      board_ptr(board) {
-}
+FourByFour_Position::FourByFour_Position(FourByFour_Board *board, char symbol) : board(board), side(symbol) {}
 
-Player<char> *FourByFour_UI::create_player(string &name, char symbol, PlayerType type) {
-    return new Player<char>(name, symbol, type);
+int FourByFour_Position::generate_moves(MoveList<char> &moves) const {
+    return board->generate_moves(side, moves);
 }
 
-
-int FourByFour_UI::minimax(int depth, bool isMaximizing, char ai_symbol, char opp_symbol) {
-    if (board_ptr->check_win_for_symbol(ai_symbol))
-        return 1000 + depth; // earlier win is better
-
-    if (board_ptr->check_win_for_symbol(opp_symbol))
-        return -1000 - depth; // later loss is better
-
-    if (depth == 0)
-        return 0;
-
-    char current_symbol = isMaximizing ? ai_symbol : opp_symbol;
-    vector<FourByFour_Move> moves = board_ptr->get_valid_moves(current_symbol);
-
-    if (moves.empty())
-        return 0;
-
-    if (isMaximizing) {
-        int bestVal = -1000000;
-
-        for (auto &move: moves) {
-            int fr = move.get_from_r();
-            int fc = move.get_from_c();
-            int tr = move.get_to_r();
-            int tc = move.get_to_c();
-
-            // Apply move for AI
-            board_ptr->set_cell(tr, tc, current_symbol);
-            board_ptr->set_cell(fr, fc, '.');
-
-            int val = minimax(depth - 1, false, ai_symbol, opp_symbol);
-
-            // Undo move
-            board_ptr->set_cell(fr, fc, current_symbol);
-            board_ptr->set_cell(tr, tc, '.');
-
-            if (val > bestVal)
-                bestVal = val;
-        }
-        return bestVal;
-    } else {
-        int bestVal = 1000000;
-
-        for (auto &move: moves) {
-            int fr = move.get_from_r();
-            int fc = move.get_from_c();
-            int tr = move.get_to_r();
-            int tc = move.get_to_c();
-
-            // Apply move for opponent
-            board_ptr->set_cell(tr, tc, current_symbol);
-            board_ptr->set_cell(fr, fc, '.');
-
-            int val = minimax(depth - 1, true, ai_symbol, opp_symbol);
-
-            // Undo move
-            board_ptr->set_cell(fr, fc, current_symbol);
-            board_ptr->set_cell(tr, tc, '.');
-
-            if (val < bestVal)
-                bestVal = val;
-        }
-        return bestVal;
-    }
+void FourByFour_Position::make_move(const Move<char> &move) {
+    board->set_cell(move.get_x(), move.get_y(), side);
+    board->set_cell(move.get_from_x(), move.get_from_y(), '.');
+    last_x = move.get_x();
+    last_y = move.get_y();
+    side = (side == 'X') ? 'O' : 'X';
 }
 
-FourByFour_Move FourByFour_UI::find_best_move(char ai, char opp, int depth) {
-    auto moves = board_ptr->get_valid_moves(ai);
-
-    int bestVal = -10000000;
-    FourByFour_Move bestMove(0, 0, 0, 0, ai);
-
-    for (auto &move: moves) {
-        int fr = move.get_from_r();
-        int fc = move.get_from_c();
-        int tr = move.get_to_r();
-        int tc = move.get_to_c();
+void FourByFour_Position::undo_move(const Move<char> &move) {
+    side = (side == 'X') ? 'O' : 'X';
+    board->set_cell(move.get_from_x(), move.get_from_y(), side);
+    board->set_cell(move.get_x(), move.get_y(), '.');
+}
 
-        // Apply
-        board_ptr->set_cell(tr, tc, ai);
-        board_ptr->set_cell(fr, fc, '.');
+Outcome FourByFour_Position::last_move_outcome() const {
+    // Sliding away never completes a line for the opponent
+    return board->has_line_through(last_x, last_y, 3) ? Outcome::WIN : Outcome::ONGOING;
+}
 
-        int val = minimax(depth - 1, false, ai, opp);
+uint64_t FourByFour_Position::key() const {
+    return board->get_hash() ^ search_side_key(side);
+}
 
-        // Undo
-        board_ptr->set_cell(fr, fc, ai);
-        board_ptr->set_cell(tr, tc, '.');
+// ---------------------------------------
+// FourByFour_UI Implementation
+// ---------------------------------------
 
-        if (val > bestVal) {
-            bestVal = val;
-            bestMove = move;
-        }
-    }
+FourByFour_UI::FourByFour_UI(FourByFour_Board *board)
+    : UI<char>("Welcome to 4x4 Tic-Tac-Toe! Move your pieces to align 3.", 3),
+      board_ptr(board) {
+}
 
-    return bestMove;
+Player<char> *FourByFour_UI::create_player(string &name, char symbol, PlayerType type) {
+    return new Player<char>(name, symbol, type);
 }
 
+
 Move<char> *FourByFour_UI::get_move(Player<char> *player) {
     char symbol = player->get_symbol();
 
@@ -318,12 +270,10 @@ Move<char> *FourByFour_UI::get_move(Player<char> *player) {
                 continue;
             }
 
-            return new FourByFour_Move(fr, fc, tr, tc, symbol);
+            return slide_slot.emplace(fr, fc, tr, tc, symbol);
         }
     } else {
-        char opp = (symbol == 'X') ? 'O' : 'X';
-
-        FourByFour_Move best = find_best_move(symbol, opp, 6);
+        FourByFour_Move best = board_ptr->find_best_move(symbol, 6);
 
 
         cout << "AI (" << player->get_name() << ") moves" << symbol << "from ("
@@ -331,12 +281,6 @@ Move<char> *FourByFour_UI::get_move(Player<char> *player) {
                 << ") to (" << best.get_to_r()
                 << "," << best.get_to_c() << ")\n";
 
-        return new FourByFour_Move(
-            best.get_from_r(),
-            best.get_from_c(),
-            best.get_to_r(),
-            best.get_to_c(),
-            symbol
-        );
+        return slide_slot.store(best);
     }
 }
@@ -9,6 +9,7 @@
 #define FOURBYFOUR_CLASSES_H
 
 #include "BoardGame_Classes.h"
+#include "Search_Classes.h"
 #include <vector>
 #include <string>
 #include <cmath>
@@ -21,11 +22,6 @@ using namespace std;
  * @brief Represents a move in the 4x4 game (Source -> Destination).
  */
 class FourByFour_Move : public Move<char> {
-    int from_r; ///< Source row.
-    int from_c; ///< Source column.
-    int to_r;   ///< Destination row.
-    int to_c;   ///< Destination column.
-
 public:
     /**
      * @brief Constructs a move object.
@@ -33,15 +29,50 @@ public:
     FourByFour_Move(int from_r, int from_c,
                     int to_r,   int to_c,
                     char symbol)
-        // We still call base constructor, but we treat x,y as "from" only.
-        : Move<char>(from_r, from_c, symbol),
-          from_r(from_r), from_c(from_c),
-          to_r(to_r), to_c(to_c) {}
-
-    int get_from_r() const { return from_r; }
-    int get_from_c() const { return from_c; }
-    int get_to_r()   const { return to_r;   }
-    int get_to_c()   const { return to_c;   }
+        // Source goes in the base "from" fields, destination in x,y.
+        : Move<char>(from_r, from_c, to_r, to_c, symbol) {}
+
+    /**
+     * @brief Wraps a slide produced by the generic move generator.
+     */
+    explicit FourByFour_Move(const Move<char>& move) : Move<char>(move) {}
+
+    int get_from_r() const { return get_from_x(); }
+    int get_from_c() const { return get_from_y(); }
+    int get_to_r()   const { return get_x();      }
+    int get_to_c()   const { return get_y();      }
+};
+
+class FourByFour_Board;
+
+/**
+ * @class FourByFour_Position
+ * @brief Search view of a FourByFour_Board for AlphaBetaSearch.
+ *
+ * Slides tokens directly on the board. Only wins are scored; quiet leaves
+ * are worth 0 to both sides.
+ */
+class FourByFour_Position {
+public:
+    typedef char Symbol;
+
+    /**
+     * @brief Starts a search on `board` with `symbol` to move.
+     */
+    FourByFour_Position(FourByFour_Board* board, char symbol);
+
+    int generate_moves(MoveList<char>& moves) const;
+    void make_move(const Move<char>& move);
+    void undo_move(const Move<char>& move);
+    Outcome last_move_outcome() const;
+    int evaluate() const { return 0; }
+    uint64_t key() const;
+
+private:
+    FourByFour_Board* board;
+    char side;       ///< Side to move.
+    int last_x = -1; ///< Row the last token slid to.
+    int last_y = -1; ///< Column the last token slid to.
 };
 
 /**
@@ -49,6 +80,10 @@ public:
  * @brief Logic for 4x4 Sliding Tic-Tac-Toe.
  */
 class FourByFour_Board : public Board<char> {
+    friend class FourByFour_Position;
+
+    AlphaBetaSearch<FourByFour_Position> search; ///< Engine behind find_best_move().
+
 public:
     /**
      * @brief Constructor for 4x4 Board.
@@ -89,11 +124,15 @@ public:
      */
     bool game_is_over(Player<char>* player) override;
 
+    /**
+     * @brief Win if the moved token completes a line of three.
+     */
+    Outcome evaluate_last_move(Player<char>* player) override;
 
     /**
-     * @brief Gets all valid sliding moves for a symbol.
+     * @brief Every one-step slide of a `symbol` token into an empty neighbour.
      */
-    vector<FourByFour_Move> get_valid_moves(char symbol);
+    int generate_moves(char symbol, MoveList<char>& moves) const override;
 
     /**
      * @brief Checks if a specific symbol has a winning line.
@@ -105,9 +144,15 @@ public:
      */
     int calc_heuristic_value(char ai_symbol, char opp_symbol);
 
-    // Direct board manipulation for AI simulation
-    void set_cell(int r, int c, char symbol) { board[r][c] = symbol; }
-    char get_cell(int r, int c) const { return board[r][c]; }
+    /**
+     * @brief Finds the best sliding move for the AI with an alpha-beta search.
+     * @param ai AI's symbol.
+     * @param depth Search depth in plies.
+     */
+    FourByFour_Move find_best_move(char ai, int depth);
+
+    /** @brief Positions visited by all searches of this board so far. */
+    long long get_search_nodes() const { return search.nodes_searched(); }
 };
 
 /**
@@ -117,9 +162,7 @@ public:
 class FourByFour_UI : public UI<char> {
 private:
     FourByFour_Board* board_ptr;
-
-    int minimax(int depth, bool isMaximizing, char ai_symbol, char opp_symbol);
-    FourByFour_Move find_best_move(char ai, char opp, int depth);
+    MoveSlot<FourByFour_Move> slide_slot; ///< Storage for the returned sliding moves
 
 public:
     FourByFour_UI(FourByFour_Board* board);
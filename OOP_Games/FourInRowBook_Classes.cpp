@@ -0,0 +1,229 @@
+/**
+ * @file FourInRowBook_Classes.cpp
+ * @brief Implementation of the Four-in-a-Row opening book.
+ */
+
+#include "FourInRowBook_Classes.h"
+#include "FourInRowSolver_Classes.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <unordered_map>
+#include <unordered_set>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+namespace {
+
+const char MAGIC[8] = {'C', '4', 'B', 'O', 'O', 'K', '1', '\0'};
+const size_t HEADER_SIZE = 24; ///< Magic, plies, entry count
+
+const int H = FourInRow_Bitboard::HEIGHT;
+const int COLUMNS = FourInRow_Bitboard::COLUMNS;
+const uint64_t COLUMN_BITS = (uint64_t(1) << H) - 1;
+
+/** @brief `bits` with the columns in reverse order. */
+uint64_t mirror(uint64_t bits) {
+    uint64_t m = 0;
+    for (int c = 0; c < COLUMNS; ++c)
+        m |= ((bits >> (c * H)) & COLUMN_BITS) << ((COLUMNS - 1 - c) * H);
+    return m;
+}
+
+uint64_t pack(uint64_t key, int value, int column) {
+    return key << 10 | uint64_t(value) << 3 | uint64_t(column);
+}
+
+/** @brief A position of the book being built. */
+struct BookNode {
+    FourInRow_Bitboard bits;
+    uint64_t key;
+    bool mirrored;
+};
+
+} // namespace
+
+const char* FourInRow_Book::DEFAULT_PATH = "fourinrow_book.bin";
+
+FourInRow_Book::~FourInRow_Book() { close(); }
+
+uint64_t FourInRow_Book::canonical_key(const FourInRow_Bitboard& bits, bool& mirrored) {
+    uint64_t x = bits.discs_of(0);
+    uint64_t all = x | bits.discs_of(1);
+    uint64_t key = x + all;
+    uint64_t reflected = mirror(x) + mirror(all);
+    mirrored = reflected < key;
+    return mirrored ? reflected : key;
+}
+
+bool FourInRow_Book::open(const string& path) {
+    close();
+
+#ifndef _WIN32
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    void* data = MAP_FAILED;
+    if (fstat(fd, &st) == 0 && st.st_size >= (off_t)HEADER_SIZE)
+        data = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd); // The mapping outlives the descriptor
+    if (data == MAP_FAILED) return false;
+    mapping = data;
+    mapping_size = st.st_size;
+    const char* bytes = static_cast<const char*>(data);
+#else
+    ifstream in(path, ios::binary);
+    if (!in) return false;
+    in.seekg(0, ios::end);
+    size_t size = (size_t)in.tellg();
+    if (size < HEADER_SIZE) return false;
+    fallback.resize((size + 7) / 8);
+    in.seekg(0);
+    in.read(reinterpret_cast<char*>(fallback.data()), size);
+    mapping_size = size;
+    const char* bytes = reinterpret_cast<const char*>(fallback.data());
+#endif
+
+    uint64_t header[2];
+    memcpy(header, bytes + sizeof(MAGIC), sizeof(header));
+    if (memcmp(bytes, MAGIC, sizeof(MAGIC)) != 0 || header[1] > (mapping_size - HEADER_SIZE) / 8) {
+        close();
+        return false;
+    }
+    plies = (int)header[0];
+    count = (size_t)header[1];
+    entries = reinterpret_cast<const uint64_t*>(bytes + HEADER_SIZE);
+    return true;
+}
+
+void FourInRow_Book::close() {
+#ifndef _WIN32
+    if (mapping) munmap(mapping, mapping_size);
+#endif
+    mapping = nullptr;
+    mapping_size = 0;
+    fallback.clear();
+    entries = nullptr;
+    count = 0;
+    plies = 0;
+}
+
+bool FourInRow_Book::lookup(const FourInRow_Bitboard& bits, int& column, int* score) const {
+    if (count == 0) return false;
+    bool mirrored;
+    uint64_t key = canonical_key(bits, mirrored);
+    const uint64_t* end = entries + count;
+    const uint64_t* it = lower_bound(entries, end, key << 10);
+    if (it == end || (*it >> 10) != key) return false;
+
+    int col = int(*it & 7);
+    column = mirrored ? COLUMNS - 1 - col : col;
+    int value = int((*it >> 3) & 0x7F);
+    if (score && value != 0) *score = value - 32;
+    return true;
+}
+
+const FourInRow_Book& FourInRow_Book::shared() {
+    static FourInRow_Book book;
+    static bool opened = book.open(DEFAULT_PATH);
+    (void)opened;
+    return book;
+}
+
+/**
+ * Positions are collected ply by ply, one per mirror pair. In exact mode
+ * only the last ply is solved; every shallower position takes the best of
+ * its children, which are all in the book already (or are immediate wins).
+ * Otherwise each position gets its own budgeted search.
+ */
+vector<uint64_t> FourInRow_Book::build(const FourInRowBookOptions& options) {
+    vector<vector<BookNode>> levels(options.plies + 1);
+    unordered_map<uint64_t, int> scores; // Exact mode: canonical key -> score
+    bool mirrored;
+    uint64_t root_key = canonical_key(options.root, mirrored);
+    levels[0].push_back({options.root, root_key, mirrored});
+    int base = __builtin_popcountll(options.root.discs_of(0) | options.root.discs_of(1));
+
+    for (int ply = 0; ply < options.plies; ++ply) {
+        int side = (base + ply) % 2;
+        unordered_set<uint64_t> seen;
+        for (const BookNode& node : levels[ply])
+            for (int col = 0; col < COLUMNS; ++col) {
+                if (!node.bits.can_drop(col)) continue;
+                FourInRow_Bitboard child = node.bits;
+                child.drop(col, side);
+                if (FourInRow_Bitboard::has_line(child.discs_of(side))) continue; // Game over
+                uint64_t key = canonical_key(child, mirrored);
+                if (seen.insert(key).second) levels[ply + 1].push_back({child, key, mirrored});
+            }
+    }
+
+    int total = 0, done = 0;
+    for (const vector<BookNode>& level : levels) total += (int)level.size();
+
+    vector<uint64_t> entries;
+    entries.reserve(total);
+    FourInRow_Solver solver;
+    AlphaBetaSearch<FourInRow_Position> search(20);
+    SearchLimits limits;
+    limits.max_nodes = options.max_nodes;
+
+    for (int ply = options.plies; ply >= 0; --ply) {
+        int side = (base + ply) % 2;
+        char symbol = side == 0 ? 'X' : 'O';
+        for (const BookNode& node : levels[ply]) {
+            int col = -1, value = 0;
+            if (!options.exact) {
+                FourInRow_Position pos(node.bits, symbol);
+                SearchResult<char> result = search.search(pos, limits);
+                col = result.best.get_y();
+            } else if (ply == options.plies) {
+                FourInRow_Solution solution;
+                col = solver.best_column(node.bits, symbol, &solution);
+                value = solution.score;
+            } else {
+                MoveList<char> moves;
+                node.bits.generate_moves(symbol, moves); // Centre first, so it wins ties
+                for (const Move<char>& m : moves) {
+                    FourInRow_Bitboard child = node.bits;
+                    child.drop(m.get_y(), side);
+                    int child_value;
+                    if (FourInRow_Bitboard::has_line(child.discs_of(side))) {
+                        child_value = (FourInRow_Bitboard::ROWS * COLUMNS + 1 - base - ply) / 2;
+                    } else {
+                        bool child_mirrored;
+                        child_value = -scores.at(canonical_key(child, child_mirrored));
+                    }
+                    if (col == -1 || child_value > value) {
+                        col = m.get_y();
+                        value = child_value;
+                    }
+                }
+            }
+            if (options.exact) scores[node.key] = value;
+
+            int stored_col = node.mirrored ? COLUMNS - 1 - col : col;
+            entries.push_back(pack(node.key, options.exact ? value + 32 : 0, stored_col));
+            if (options.progress) options.progress(++done, total);
+        }
+    }
+    sort(entries.begin(), entries.end());
+    return entries;
+}
+
+bool FourInRow_Book::write(const string& path, const vector<uint64_t>& entries, int plies) {
+    ofstream out(path, ios::binary);
+    if (!out) return false;
+    uint64_t header[2] = {uint64_t(plies), uint64_t(entries.size())};
+    out.write(MAGIC, sizeof(MAGIC));
+    out.write(reinterpret_cast<const char*>(header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(uint64_t));
+    return bool(out);
+}
@@ -0,0 +1,114 @@
+/**
+ * @file FourInRowBook_Classes.h
+ * @brief Opening book for the Four-in-a-Row computer player.
+ *
+ * The book maps every position of the first few plies to the column to
+ * play. It is built offline by the `fourinrow_book` tool and stored as a
+ * sorted array of 64-bit entries, which the game maps into memory as it
+ * is and searches by bisection: nothing is parsed or copied at startup.
+ */
+
+#ifndef FOURINROWBOOK_CLASSES_H
+#define FOURINROWBOOK_CLASSES_H
+
+#include "FourInRow_Classes.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/**
+ * @struct FourInRowBookOptions
+ * @brief How FourInRow_Book::build() values the positions.
+ */
+struct FourInRowBookOptions {
+    FourInRow_Bitboard root;   ///< Where the book starts; the empty board by default.
+    int plies = 4;             ///< Book every position up to this many moves past `root`.
+    bool exact = false;        ///< Solve the deepest positions exactly (slow below ~12 discs).
+    long long max_nodes = 4000000; ///< Search budget per position when not exact.
+    function<void(int done, int total)> progress; ///< Called after each position, if set.
+};
+
+/**
+ * @class FourInRow_Book
+ * @brief Read-only view of an opening book file, and its builder.
+ *
+ * File layout (native byte order): the 8-byte magic "C4BOOK1\0", the
+ * number of plies and of entries as two 64-bit integers, then the entries
+ * in increasing order. An entry packs `key << 10 | value << 3 | column`:
+ * - `key` is the smaller of the position's code and its mirror image's
+ *   (X's discs plus all discs, in the bitboard layout), so a position and
+ *   its reflection share one entry;
+ * - `value` is the perfect-play score for the side to move plus 32
+ *   (see FourInRow_Solver), or 0 when the column comes from a search;
+ * - `column` is the move for the canonical orientation.
+ */
+class FourInRow_Book {
+public:
+    FourInRow_Book() = default;
+    ~FourInRow_Book();
+    FourInRow_Book(const FourInRow_Book&) = delete;
+    FourInRow_Book& operator=(const FourInRow_Book&) = delete;
+
+    /** @brief Name of the book the game loads from its working directory. */
+    static const char* DEFAULT_PATH;
+
+    /**
+     * @brief Maps the book at `path`, replacing any open one.
+     * @return false (and an empty book) if the file is missing or malformed.
+     */
+    bool open(const string& path);
+
+    /** @brief Unmaps the book. */
+    void close();
+
+    /** @brief Number of positions in the book. */
+    size_t size() const { return count; }
+
+    /** @brief Plies the book was built to. */
+    int get_plies() const { return plies; }
+
+    /**
+     * @brief Looks up a position.
+     * @param column Receives the column to play.
+     * @param score Optional, receives the perfect-play score for the side to
+     * move when the book was solved exactly (left alone otherwise).
+     * @return true if the position is in the book.
+     */
+    bool lookup(const FourInRow_Bitboard& bits, int& column, int* score = nullptr) const;
+
+    /**
+     * @brief The book found at DEFAULT_PATH, mapped on first use and shared
+     * by every board; empty if there is no such file.
+     */
+    static const FourInRow_Book& shared();
+
+    /**
+     * @brief Values every position up to `options.plies` moves past the root
+     * and returns the sorted entries. Positions where the game is already
+     * over are left out.
+     */
+    static vector<uint64_t> build(const FourInRowBookOptions& options);
+
+    /**
+     * @brief Writes `entries` (sorted, as returned by build()) to `path`.
+     * @return false if the file cannot be written.
+     */
+    static bool write(const string& path, const vector<uint64_t>& entries, int plies);
+
+private:
+    const uint64_t* entries = nullptr; ///< Into the mapping (or `fallback`).
+    size_t count = 0;
+    int plies = 0;
+    void* mapping = nullptr;           ///< Start of the mapped file, if mapped.
+    size_t mapping_size = 0;
+    vector<uint64_t> fallback;         ///< File contents where mmap is unavailable.
+
+    /** @brief Canonical key of `bits`; `mirrored` tells which orientation gave it. */
+    static uint64_t canonical_key(const FourInRow_Bitboard& bits, bool& mirrored);
+};
+
+#endif // FOURINROWBOOK_CLASSES_H
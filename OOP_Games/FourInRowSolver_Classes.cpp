@@ -0,0 +1,251 @@
+/**
+ * @file FourInRowSolver_Classes.cpp
+ * @brief Implementation of the exact Four-in-a-Row solver.
+ */
+
+#include "FourInRowSolver_Classes.h"
+
+using namespace std;
+
+namespace {
+
+const int H = FourInRow_Bitboard::HEIGHT;
+
+/** @brief One bit at the bottom of every column. */
+const uint64_t BOTTOM_MASK = [] {
+    uint64_t m = 0;
+    for (int c = 0; c < FourInRow_Bitboard::COLUMNS; ++c) m |= uint64_t(1) << (c * H);
+    return m;
+}();
+
+/** @brief Every playable cell. */
+const uint64_t BOARD_MASK = BOTTOM_MASK * ((uint64_t(1) << FourInRow_Bitboard::ROWS) - 1);
+
+/** @brief Cells of column `col`. */
+uint64_t column_mask(int col) {
+    return ((uint64_t(1) << FourInRow_Bitboard::ROWS) - 1) << (col * H);
+}
+
+int popcount(uint64_t bits) { return __builtin_popcountll(bits); }
+
+} // namespace
+
+FourInRow_Solver::FourInRow_Solver(int table_bits) : table_bits(table_bits) {}
+
+void FourInRow_Solver::clear() {
+    fill(table.begin(), table.end(), 0);
+}
+
+FourInRow_Solver::Node FourInRow_Solver::make_node(const FourInRow_Bitboard& bits, int side) {
+    Node node;
+    node.current = bits.discs_of(side);
+    node.mask = bits.discs_of(0) | bits.discs_of(1);
+    node.moves = popcount(node.mask);
+    return node;
+}
+
+void FourInRow_Solver::play(Node& node, uint64_t move) {
+    node.current ^= node.mask;
+    node.mask |= move;
+    node.moves++;
+}
+
+uint64_t FourInRow_Solver::possible(const Node& node) {
+    return (node.mask + BOTTOM_MASK) & BOARD_MASK;
+}
+
+/**
+ * @brief Empty cells where `position` would complete a four, found for all
+ * cells at once with shifts (vertical, horizontal, both diagonals).
+ */
+uint64_t FourInRow_Solver::winning_cells(uint64_t position, uint64_t mask) {
+    // Vertical: three above each other, the cell on top
+    uint64_t r = (position << 1) & (position << 2) & (position << 3);
+
+    for (int shift : {H, H - 1, H + 1}) {
+        // Three in a row with the gap at either end or in one of the middles
+        uint64_t p = (position << shift) & (position << 2 * shift);
+        r |= p & (position << 3 * shift);
+        r |= p & (position >> shift);
+        p = (position >> shift) & (position >> 2 * shift);
+        r |= p & (position << shift);
+        r |= p & (position >> 3 * shift);
+    }
+    return r & (BOARD_MASK ^ mask);
+}
+
+bool FourInRow_Solver::can_win_next(const Node& node) {
+    return winning_cells(node.current, node.mask) & possible(node);
+}
+
+/**
+ * @brief Playable cells that do not lose at once: if the opponent threatens
+ * to win, only the block (and nothing when there are two threats); never a
+ * cell right below one of the opponent's winning cells.
+ */
+uint64_t FourInRow_Solver::non_losing_moves(const Node& node) {
+    uint64_t moves = possible(node);
+    uint64_t opponent_wins = winning_cells(node.current ^ node.mask, node.mask);
+    uint64_t forced = moves & opponent_wins;
+    if (forced) {
+        if (forced & (forced - 1)) return 0;
+        moves = forced;
+    }
+    return moves & ~(opponent_wins >> 1);
+}
+
+int FourInRow_Solver::negamax(const Node& node, int alpha, int beta) {
+    ++nodes;
+
+    uint64_t next = non_losing_moves(node);
+    if (next == 0) return -(CELLS - node.moves) / 2; // Every move loses at once
+    if (node.moves >= CELLS - 2) return 0;           // Draw: neither side can win in the last two
+
+    // The opponent cannot win on their next move, so this bounds the score from below
+    int lowest = -(CELLS - 2 - node.moves) / 2;
+    if (alpha < lowest) {
+        alpha = lowest;
+        if (alpha >= beta) return alpha;
+    }
+
+    // We cannot win on this move (checked by the caller), so this bounds it from above
+    int highest = (CELLS - 1 - node.moves) / 2;
+    uint64_t key = node.current + node.mask;
+    uint64_t slot = table[key & (table.size() - 1)];
+    if (slot && (slot >> 8) == key) highest = int(slot & 0xFF) - CELLS;
+    if (beta > highest) {
+        beta = highest;
+        if (alpha >= beta) return beta;
+    }
+
+    // Order by new threats created, centre columns first on ties (insertion sort, stable)
+    uint64_t children[WIDTH];
+    int threat_counts[WIDTH];
+    int n = 0;
+    for (int k = 0; k < WIDTH; ++k) {
+        int col = WIDTH / 2 + ((k % 2) ? -(k + 1) / 2 : k / 2);
+        uint64_t move = next & column_mask(col);
+        if (!move) continue;
+        int threats = popcount(winning_cells(node.current | move, node.mask | move));
+        int i = n++;
+        for (; i > 0 && threat_counts[i - 1] < threats; --i) {
+            children[i] = children[i - 1];
+            threat_counts[i] = threat_counts[i - 1];
+        }
+        children[i] = move;
+        threat_counts[i] = threats;
+    }
+
+    for (int i = 0; i < n; ++i) {
+        Node child = node;
+        play(child, children[i]);
+        int score = -negamax(child, -beta, -alpha);
+        if (score >= beta) return score;
+        if (score > alpha) alpha = score;
+    }
+
+    table[key & (table.size() - 1)] = key << 8 | uint64_t(alpha + CELLS);
+    return alpha;
+}
+
+/**
+ * @brief Narrows [lowest, highest] with null-window searches around the
+ * middle, biased towards 0 so that draws and near-draws are settled first.
+ */
+int FourInRow_Solver::solve_score(const Node& node) {
+    if (can_win_next(node)) return (CELLS + 1 - node.moves) / 2;
+
+    int lowest = -(CELLS - node.moves) / 2;
+    int highest = (CELLS + 1 - node.moves) / 2;
+    while (lowest < highest) {
+        int med = lowest + (highest - lowest) / 2;
+        if (med <= 0 && lowest / 2 < med) med = lowest / 2;
+        else if (med >= 0 && highest / 2 > med) med = highest / 2;
+        int r = negamax(node, med, med + 1);
+        if (r <= med) highest = r;
+        else lowest = r;
+    }
+    return lowest;
+}
+
+/**
+ * @brief Turns a score into an outcome and a distance in plies.
+ *
+ * A win scored s ends when the winner places disc number 22 - s; the side
+ * to move has moves / 2 discs now, the opponent (moves + 1) / 2.
+ */
+FourInRow_Solution FourInRow_Solver::to_solution(int score, int moves) {
+    FourInRow_Solution solution;
+    solution.score = score;
+    if (score > 0) {
+        solution.outcome = Outcome::WIN;
+        solution.plies = 2 * ((CELLS / 2 + 1 - score) - moves / 2) - 1;
+    } else if (score < 0) {
+        solution.outcome = Outcome::LOSE;
+        solution.plies = 2 * ((CELLS / 2 + 1 + score) - (moves + 1) / 2);
+    } else {
+        solution.outcome = Outcome::DRAW;
+        solution.plies = CELLS - moves;
+    }
+    return solution;
+}
+
+FourInRow_Solution FourInRow_Solver::solve(const FourInRow_Bitboard& bits, char side_to_move) {
+    int side = FourInRow_Bitboard::side_index(side_to_move);
+    Node node = make_node(bits, side);
+    FourInRow_Solution solution;
+
+    if (FourInRow_Bitboard::has_line(node.current ^ node.mask)) {
+        solution.outcome = Outcome::LOSE;
+        return solution;
+    }
+    if (node.moves == CELLS) return solution;
+
+    if (table.empty()) table.assign(size_t(1) << table_bits, 0);
+    nodes = 0;
+    solution = to_solution(solve_score(node), node.moves);
+    solution.nodes = nodes;
+    return solution;
+}
+
+FourInRow_Solution FourInRow_Solver::solve(const FourInRow_Board& board, char side_to_move) {
+    return solve(board.get_bitboard(), side_to_move);
+}
+
+/**
+ * Once the position's score is known, each column only needs a null-window
+ * test of whether it keeps that score, which is much cheaper than solving
+ * the child outright.
+ */
+int FourInRow_Solver::best_column(const FourInRow_Bitboard& bits, char side_to_move, FourInRow_Solution* value) {
+    int side = FourInRow_Bitboard::side_index(side_to_move);
+    Node node = make_node(bits, side);
+
+    FourInRow_Solution position = solve(bits, side_to_move);
+    if (value) *value = position;
+    if (node.moves == CELLS || FourInRow_Bitboard::has_line(node.current ^ node.mask)) return -1;
+
+    int best_col = -1;
+    MoveList<char> moves;
+    bits.generate_moves(side_to_move, moves);
+    for (const Move<char>& m : moves) {
+        int col = m.get_y();
+        uint64_t move = possible(node) & column_mask(col);
+        if (winning_cells(node.current, node.mask) & move) return col; // Nothing beats winning now
+        Node child = node;
+        play(child, move);
+        if (can_win_next(child)) continue; // Gives the opponent a four
+        // The column keeps the score iff the child is worth at most -score to the opponent
+        if (-negamax(child, -position.score, -position.score + 1) >= position.score) {
+            best_col = col;
+            break;
+        }
+    }
+    if (best_col == -1) best_col = moves[0].get_y(); // Every column loses at once
+    if (value) value->nodes = nodes;
+    return best_col;
+}
+
+int FourInRow_Solver::best_column(const FourInRow_Board& board, char side_to_move, FourInRow_Solution* value) {
+    return best_column(board.get_bitboard(), side_to_move, value);
+}
@@ -0,0 +1,107 @@
+/**
+ * @file FourInRowSolver_Classes.h
+ * @brief Exact solver for 6x7 Four-in-a-Row positions.
+ *
+ * Unlike the heuristic get_best_move(), the solver searches every line to
+ * the end and reports the game-theoretic result: who wins with perfect
+ * play, and how many moves it takes. Works on the board's
+ * FourInRow_Bitboard layout (7 bits per column, bottom first).
+ */
+
+#ifndef FOURINROWSOLVER_CLASSES_H
+#define FOURINROWSOLVER_CLASSES_H
+
+#include "FourInRow_Classes.h"
+#include <cstdint>
+#include <vector>
+
+using namespace std;
+
+/**
+ * @struct FourInRow_Solution
+ * @brief Perfect-play value of a position, for the side to move.
+ */
+struct FourInRow_Solution {
+    Outcome outcome = Outcome::DRAW; ///< WIN, LOSE or DRAW for the side to move.
+    int plies = 0;         ///< Moves (both sides) until the game ends with best play.
+    int score = 0;         ///< Solver score: positive wins, negative loses, larger is sooner.
+    long long nodes = 0;   ///< Positions visited.
+};
+
+/**
+ * @class FourInRow_Solver
+ * @brief Null-window alpha-beta over the full game tree.
+ *
+ * Scores follow the usual Connect-4 solver convention: a win is worth
+ * 22 minus the number of discs the winner has when it connects, so faster
+ * wins score higher; a loss is the negation and a draw is 0. solve() finds
+ * the score by a binary search of null-window searches. Each search
+ * - only tries moves that do not hand the opponent an immediate win, and
+ *   plays a forced block at once,
+ * - tries first the moves that create the most new threats (cells that
+ *   would complete a four), centre columns breaking ties,
+ * - keeps upper bounds in a transposition table shared by all searches
+ *   of the solver.
+ */
+class FourInRow_Solver {
+public:
+    /**
+     * @brief Creates a solver with a table of 2^table_bits entries
+     * (8 bytes each; the default is 64 MB, allocated on the first solve).
+     */
+    explicit FourInRow_Solver(int table_bits = 23);
+
+    /**
+     * @brief Solves `bits` with `side_to_move` ('X' or 'O') to play.
+     *
+     * A position already won by the side that just moved is a loss in 0
+     * plies; a full board is a draw in 0 plies.
+     */
+    FourInRow_Solution solve(const FourInRow_Bitboard& bits, char side_to_move);
+
+    /** @brief Same, for the position on `board`. */
+    FourInRow_Solution solve(const FourInRow_Board& board, char side_to_move);
+
+    /**
+     * @brief Best column for `side_to_move` under perfect play: the fastest
+     * win, else a draw, else the slowest loss (centre columns on ties).
+     * @param value Optional, receives the value of the position.
+     * @return The column, or -1 if the game is already over.
+     */
+    int best_column(const FourInRow_Bitboard& bits, char side_to_move, FourInRow_Solution* value = nullptr);
+
+    /** @brief Same, for the position on `board`. */
+    int best_column(const FourInRow_Board& board, char side_to_move, FourInRow_Solution* value = nullptr);
+
+    /** @brief Forgets every stored position. */
+    void clear();
+
+private:
+    static const int WIDTH = FourInRow_Bitboard::COLUMNS;
+    static const int ROWS = FourInRow_Bitboard::ROWS;
+    static const int CELLS = WIDTH * ROWS;
+
+    /** @brief Side-to-move discs, all discs and disc count of a position. */
+    struct Node {
+        uint64_t current;
+        uint64_t mask;
+        int moves;
+    };
+
+    int table_bits;
+    vector<uint64_t> table; ///< key << 8 | (upper bound + CELLS), never 0 once written
+    long long nodes = 0;
+
+    int negamax(const Node& node, int alpha, int beta);
+    int solve_score(const Node& node);
+
+    static Node make_node(const FourInRow_Bitboard& bits, int side);
+    static void play(Node& node, uint64_t move);
+    static uint64_t possible(const Node& node);
+    static uint64_t winning_cells(uint64_t position, uint64_t mask);
+    static uint64_t non_losing_moves(const Node& node);
+    static bool can_win_next(const Node& node);
+    static FourInRow_Solution to_solution(int score, int moves);
+};
+
+#endif // FOURINROWSOLVER_CLASSES_H
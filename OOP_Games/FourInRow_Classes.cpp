@@ -4,299 +4,233 @@
  */
 
 #include "FourInRow_Classes.h"
+#include "FourInRowBook_Classes.h"
 #include <iostream>
 #include <cstdlib>
 #include <ctime>
 #include <algorithm>
 #include <limits>
+#include <thread>
 #include <vector>
 
 using namespace std;
 
+template class ConnectN_Board<6, 7, 4>;
+template class ConnectN_Board<7, 8, 4>;
+template class ConnectN_Board<8, 9, 4>;
+template class ConnectN_Board<8, 9, 5>;
+
 // --------------------------------------------------------------------
 // FourInRow_Board Implementation
 // --------------------------------------------------------------------
 
-/**
- * @brief Initializes a 6-row by 7-column board with blank symbols.
- */
-FourInRow_Board::FourInRow_Board() : Board(6, 7) {
-    for (auto& row : board) {
-        for (auto& cell : row) {
-            cell = blank_symbol;
-        }
-    }
-}
+FourInRow_Board::FourInRow_Board() : book(&FourInRow_Book::shared()) {}
 
-/**
- * @brief Applies a move using gravity logic.
- *
- * Finds the bottom-most empty row in the specified column and places the symbol there.
- */
-bool FourInRow_Board::update_board(Move<char>* move) {
-    int col = move->get_y();
-    char symbol = move->get_symbol();
+int FourInRow_Board::get_best_move(char ai_symbol) {
+    // The book only knows the usual turn order, X on even move counts
+    int col;
+    if (book && Bitboard::side_index(ai_symbol) == n_moves % 2 &&
+        book->lookup(bits, col) && is_valid_move(col))
+        return col;
 
-    if (col < 0 || col >= columns) return false;
+    return ConnectN_Board::get_best_move(ai_symbol);
+}
 
-    int row = get_next_empty_row(col);
-    if (row == -1) return false;
+// --------------------------------------------------------------------
+// ConnectN_DynamicPosition Implementation
+// --------------------------------------------------------------------
 
-    board[row][col] = symbol;
-    n_moves++;
-    return true;
+namespace {
+
+/** @brief Key of a disc of `who` on cell `index`. */
+uint64_t dynamic_cell_key(int index, int who) {
+    uint64_t z = uint64_t(index) * 2 + who + 0x2545F4914F6CDD1Dull;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
 }
 
-/**
- * @brief Scans a column from bottom to top to find the first empty slot.
- */
-int FourInRow_Board::get_next_empty_row(int col) {
-    for (int row = rows - 1; row >= 0; row--) {
-        if (board[row][col] == blank_symbol) {
-            return row;
+} // namespace
+
+ConnectN_DynamicPosition::ConnectN_DynamicPosition(const ConnectN_DynamicBoard& board, char ai_symbol)
+    : rows(board.get_rows()), columns(board.get_columns()), connect(board.connect),
+      grid(rows * columns), heights(board.heights), ai(ai_symbol == 'X' ? 0 : 1), side(ai),
+      filled(board.get_n_moves()), hash(0) {
+    for (int r = 0; r < rows; ++r)
+        for (int c = 0; c < columns; ++c) {
+            at(r, c) = board.cell(r, c);
+            if (at(r, c) != board.blank_symbol) toggle(r, c, at(r, c) == 'X' ? 0 : 1);
         }
-    }
-    return -1;
+    for (int k = 0; k < columns; ++k)
+        order.push_back(columns / 2 + ((k % 2) ? -(k + 1) / 2 : k / 2));
 }
 
-bool FourInRow_Board::check_direction(int row, int col, int delta_row, int delta_col, char symbol) {
-    int count = 0;
-    for (int i = 0; i < 4; i++) {
-        int new_row = row + i * delta_row;
-        int new_col = col + i * delta_col;
-        if (new_row < 0 || new_row >= rows || new_col < 0 || new_col >= columns) return false;
-        if (board[new_row][new_col] == symbol) count++;
-        else break;
-    }
-    return count == 4;
+void ConnectN_DynamicPosition::toggle(int r, int c, int who) {
+    hash ^= dynamic_cell_key(r * columns + c, who);
 }
 
-/**
- * @brief Checks all 4 axes (horizontal, vertical, two diagonals) for a win.
- */
-bool FourInRow_Board::check_win_condition(int row, int col, char symbol) {
-    // Horizontal, Vertical, Diagonal 1 (Positive slope), Diagonal 2 (Negative slope)
-    for (int c = max(0, col - 3); c <= min(columns - 4, col); c++)
-        if (check_direction(row, c, 0, 1, symbol)) return true;
-    for (int r = max(0, row - 3); r <= min(rows - 4, row); r++)
-        if (check_direction(r, col, 1, 0, symbol)) return true;
-    for (int r = max(0, row - 3); r <= min(rows - 4, row); r++)
-        for (int c = max(0, col - 3); c <= min(columns - 4, col); c++)
-            if (check_direction(r, c, 1, 1, symbol)) return true;
-    for (int r = max(0, row - 3); r <= min(rows - 4, row); r++)
-        for (int c = min(columns - 1, col + 3); c >= max(3, col); c--)
-            if (check_direction(r, c, 1, -1, symbol)) return true;
-
-    return false;
+int ConnectN_DynamicPosition::generate_moves(MoveList<char>& moves) const {
+    moves.clear();
+    for (int col : order)
+        if (heights[col] < rows) moves.add(rows - 1 - heights[col], col, side == 0 ? 'X' : 'O');
+    return moves.size();
 }
 
-bool FourInRow_Board::is_win(Player<char>* player) {
-    char symbol = player->get_symbol();
-    for (int row = 0; row < rows; row++) {
-        for (int col = 0; col < columns; col++) {
-            if (board[row][col] == symbol && check_win_condition(row, col, symbol)) {
-                return true;
-            }
-        }
-    }
-    return false;
+void ConnectN_DynamicPosition::make_move(const Move<char>& move) {
+    int col = move.get_y();
+    int row = rows - 1 - heights[col]++;
+    at(row, col) = side == 0 ? 'X' : 'O';
+    toggle(row, col, side);
+    history.push_back(col);
+    filled++;
+    side ^= 1;
 }
 
-bool FourInRow_Board::is_lose(Player<char>* player) { return false; }
-
-bool FourInRow_Board::is_draw(Player<char>* player) { return n_moves == rows * columns; }
-
-bool FourInRow_Board::game_is_over(Player<char>* player) { return is_win(player) || is_draw(player); }
-
-bool FourInRow_Board::is_valid_move(int col) {
-    return col >= 0 && col < columns && board[0][col] == blank_symbol;
+void ConnectN_DynamicPosition::undo_move(const Move<char>& move) {
+    side ^= 1;
+    filled--;
+    history.pop_back();
+    int col = move.get_y();
+    int row = rows - heights[col]--;
+    at(row, col) = '.';
+    toggle(row, col, side);
 }
 
 /**
- * @brief Prioritizes center columns for move ordering (heuristic optimization).
+ * @brief Walks out from the last disc along the four axes. Before the
+ * search's first move nothing has been played, so the game is still on.
  */
-vector<int> FourInRow_Board::get_valid_moves() {
-    vector<int> moves;
-    // Search order: center columns first [3, 2, 4, 1, 5, 0, 6] to improve Alpha-Beta pruning
-    int order[] = {3, 2, 4, 1, 5, 0, 6};
-    for(int col : order) {
-        if(is_valid_move(col)) moves.push_back(col);
+Outcome ConnectN_DynamicPosition::last_move_outcome() const {
+    if (history.empty()) return Outcome::ONGOING;
+    int c = history.back();
+    int r = rows - heights[c];
+    char sym = at(r, c);
+    static const int dirs[4][2] = {{0, 1}, {1, 0}, {1, 1}, {1, -1}};
+    for (const auto& d : dirs) {
+        int count = 1;
+        for (int sign : {1, -1})
+            for (int k = 1; count < connect; ++k) {
+                int rr = r + sign * k * d[0], cc = c + sign * k * d[1];
+                if (rr < 0 || rr >= rows || cc < 0 || cc >= columns || at(rr, cc) != sym) break;
+                count++;
+            }
+        if (count >= connect) return Outcome::WIN;
     }
-    return moves;
+    if (filled == rows * columns) return Outcome::DRAW;
+    return Outcome::ONGOING;
 }
 
 /**
- * @brief Heuristic scoring for a specific 4-cell window.
- * Points are awarded for connected pieces and deducted for opponent threats.
+ * @brief The bitboard's heuristic, recomputed: every window scored for the
+ * AI (see ConnectN_Tables::evaluate_window), plus 3 per AI disc in the
+ * centre column.
  */
-int FourInRow_Board::evaluate_window(const vector<char>& window, char piece) {
+int ConnectN_DynamicPosition::evaluate() const {
+    char own = ai == 0 ? 'X' : 'O';
+    static const int dirs[4][2] = {{0, 1}, {1, 0}, {1, 1}, {-1, 1}};
     int score = 0;
-    char opp_piece = (piece == 'X') ? 'O' : 'X';
-    int piece_count = 0;
-    int empty_count = 0;
-    int opp_count = 0;
-
-    for (char cell : window) {
-        if (cell == piece) piece_count++;
-        else if (cell == blank_symbol) empty_count++;
-        else if (cell == opp_piece) opp_count++;
+    for (int r = 0; r < rows; ++r) {
+        if (at(r, columns / 2) == own) score += 3;
+        for (int c = 0; c < columns; ++c)
+            for (const auto& d : dirs) {
+                int er = r + (connect - 1) * d[0], ec = c + (connect - 1) * d[1];
+                if (er < 0 || er >= rows || ec >= columns) continue;
+                int mine = 0, theirs = 0;
+                for (int i = 0; i < connect; ++i) {
+                    char v = at(r + i * d[0], c + i * d[1]);
+                    if (v == own) mine++;
+                    else if (v != '.') theirs++;
+                }
+                int empty = connect - mine - theirs;
+                if (mine == connect) score += 100;
+                else if (mine == connect - 1 && empty == 1) score += 5;
+                else if (mine == connect - 2 && empty == 2) score += 2;
+                if (theirs == connect - 1 && empty == 1) score -= 4;
+            }
     }
-
-    if (piece_count == 4) score += 100;
-    else if (piece_count == 3 && empty_count == 1) score += 5;
-    else if (piece_count == 2 && empty_count == 2) score += 2;
-
-    if (opp_count == 3 && empty_count == 1) score -= 4;
-
-    return score;
+    return side == ai ? score : -score;
 }
 
-/**
- * @brief Evaluates the entire board state for the AI.
- * Factors: Center column control, horizontal/vertical/diagonal connections.
- */
-int FourInRow_Board::score_position(char piece) {
-    int score = 0;
-
-    // 1. Center Column Preference
-    vector<char> center_array;
-    for (int i = 0; i < rows; i++) {
-        center_array.push_back(board[i][columns / 2]);
-    }
-    int center_count = 0;
-    for (char c : center_array) {
-        if (c == piece) center_count++;
-    }
-    score += center_count * 3;
-
-    // 2. Evaluate all windows
-    // Horizontal
-    for (int r = 0; r < rows; r++) {
-        for (int c = 0; c < columns - 3; c++) {
-            vector<char> window = {board[r][c], board[r][c+1], board[r][c+2], board[r][c+3]};
-            score += evaluate_window(window, piece);
-        }
-    }
-    // Vertical
-    for (int c = 0; c < columns; c++) {
-        for (int r = 0; r < rows - 3; r++) {
-            vector<char> window = {board[r][c], board[r+1][c], board[r+2][c], board[r+3][c]};
-            score += evaluate_window(window, piece);
-        }
-    }
-    // Diagonal (Positive)
-    for (int r = 0; r < rows - 3; r++) {
-        for (int c = 0; c < columns - 3; c++) {
-            vector<char> window = {board[r][c], board[r+1][c+1], board[r+2][c+2], board[r+3][c+3]};
-            score += evaluate_window(window, piece);
-        }
-    }
-    // Diagonal (Negative)
-    for (int r = 0; r < rows - 3; r++) {
-        for (int c = 0; c < columns - 3; c++) {
-            vector<char> window = {board[r+3][c], board[r+2][c+1], board[r+1][c+2], board[r][c+3]};
-            score += evaluate_window(window, piece);
-        }
-    }
-
-    return score;
+uint64_t ConnectN_DynamicPosition::key() const {
+    return hash ^ search_side_key(side);
 }
 
-/**
- * @brief Minimax Algorithm implementation with Alpha-Beta Pruning.
- */
-int FourInRow_Board::minimax(int depth, int alpha, int beta, bool maximizingPlayer, char ai_symbol) {
-    char opp_symbol = (ai_symbol == 'X') ? 'O' : 'X';
-
-    // Create temporary player objects for win checking
-    Player<char> ai_p("AI", ai_symbol, PlayerType::AI);
-    Player<char> opp_p("Opp", opp_symbol, PlayerType::AI);
-
-    if (is_win(&ai_p)) return 1000000;
-    if (is_win(&opp_p)) return -1000000;
-    if (n_moves == rows * columns) return 0; // Draw
-    if (depth == 0) return score_position(ai_symbol);
-
-    vector<int> valid_moves = get_valid_moves();
-
-    if (maximizingPlayer) {
-        int maxEval = -2000000000; // negative infinity
-        for (int col : valid_moves) {
-            int row = get_next_empty_row(col);
-
-            // Simulate Move
-            board[row][col] = ai_symbol;
-            n_moves++;
-
-            int eval = minimax(depth - 1, alpha, beta, false, ai_symbol);
+// --------------------------------------------------------------------
+// ConnectN_DynamicBoard Implementation
+// --------------------------------------------------------------------
 
-            // Undo Move
-            board[row][col] = blank_symbol;
-            n_moves--;
+ConnectN_DynamicBoard::ConnectN_DynamicBoard(int rows, int columns, int connect)
+    : ConnectN_BoardBase(rows, columns), connect(connect), heights(columns, 0) {
+    fill_cells(blank_symbol);
+    limits.max_depth = rows * columns;
+    limits.max_seconds = 0.5;
+}
 
-            maxEval = max(maxEval, eval);
-            alpha = max(alpha, eval);
-            if (beta <= alpha) break; // Pruning
-        }
-        return maxEval;
-    }
-    else {
-        int minEval = 2000000000; // positive infinity
-        for (int col : valid_moves) {
-            int row = get_next_empty_row(col);
+bool ConnectN_DynamicBoard::update_board(Move<char>* move) {
+    int col = move->get_y();
+    if (!is_valid_move(col)) return false;
 
-            // Simulate Move
-            board[row][col] = opp_symbol;
-            n_moves++;
+    int row = rows - 1 - heights[col]++;
+    set_cell(row, col, move->get_symbol());
+    n_moves++;
+    record_move(row, col);
+    return true;
+}
 
-            int eval = minimax(depth - 1, alpha, beta, true, ai_symbol);
+bool ConnectN_DynamicBoard::is_win(Player<char>* player) {
+    char sym = player->get_symbol();
+    for (int r = 0; r < rows; ++r)
+        for (int c = 0; c < columns; ++c)
+            if (cell(r, c) == sym && has_line_through(r, c, connect)) return true;
+    return false;
+}
 
-            // Undo Move
-            board[row][col] = blank_symbol;
-            n_moves--;
+Outcome ConnectN_DynamicBoard::evaluate_last_move(Player<char>*) {
+    if (last_x >= 0 && has_line_through(last_x, last_y, connect)) return Outcome::WIN;
+    if (n_moves == rows * columns) return Outcome::DRAW;
+    return Outcome::ONGOING;
+}
 
-            minEval = min(minEval, eval);
-            beta = min(beta, eval);
-            if (beta <= alpha) break; // Pruning
-        }
-        return minEval;
+int ConnectN_DynamicBoard::generate_moves(char symbol, MoveList<char>& moves) const {
+    moves.clear();
+    for (int k = 0; k < columns; ++k) {
+        int col = columns / 2 + ((k % 2) ? -(k + 1) / 2 : k / 2);
+        if (heights[col] < rows) moves.add(rows - 1 - heights[col], col, symbol);
     }
+    return moves.size();
 }
 
-int FourInRow_Board::get_best_move(char ai_symbol) {
-    int depth = 5;
-
-    vector<int> valid_moves = get_valid_moves();
-    int bestVal = -2000000000;
-    int bestMove = valid_moves[0];
-
-    for (int col : valid_moves) {
-        int row = get_next_empty_row(col);
-
-        board[row][col] = ai_symbol;
-        n_moves++;
-
-        int moveVal = minimax(depth - 1, -2000000000, 2000000000, false, ai_symbol);
+bool ConnectN_DynamicBoard::is_valid_move(int col) const {
+    return col >= 0 && col < columns && heights[col] < rows;
+}
 
-        // Undo Move
-        board[row][col] = blank_symbol;
-        n_moves--;
+int ConnectN_DynamicBoard::get_best_move(char ai_symbol) {
+    ConnectN_DynamicPosition pos(*this, ai_symbol);
+    SearchResult<char> result = search.search(pos, limits);
+    return result.found ? result.best.get_y() : -1;
+}
 
-        if (moveVal > bestVal) {
-            bestMove = col;
-            bestVal = moveVal;
-        }
-    }
-    return bestMove;
+ConnectN_BoardBase* make_connect_board(int rows, int columns, int connect) {
+    if (connect < 2 || connect > max(rows, columns) || rows < 1 || columns < 1) return nullptr;
+    if (rows == 6 && columns == 7 && connect == 4) return new FourInRow_Board();
+    if (rows == 7 && columns == 8 && connect == 4) return new ConnectN_Board<7, 8, 4>();
+    if (rows == 8 && columns == 9 && connect == 4) return new ConnectN_Board<8, 9, 4>();
+    if (rows == 8 && columns == 9 && connect == 5) return new ConnectN_Board<8, 9, 5>();
+    return new ConnectN_DynamicBoard(rows, columns, connect);
 }
 
 // --------------------------------------------------------------------
 // FourInRow_UI Implementation
 // --------------------------------------------------------------------
 
-FourInRow_UI::FourInRow_UI(FourInRow_Board* board) :
-    UI<char>("Welcome to Four-in-a-Row Game! Connect four to win.", 3), board_ptr(board) {
+FourInRow_UI::FourInRow_UI(ConnectN_BoardBase* board) :
+    UI<char>(board->get_connect() == 4 ? "Welcome to Four-in-a-Row Game! Connect four to win."
+                                       : "Welcome to Connect-" + to_string(board->get_connect()) +
+                                         "! Connect " + to_string(board->get_connect()) + " to win.", 3),
+    board_ptr(board) {
     srand(time(0));
+    // Interactive play: let the computer think on every core
+    board_ptr->set_search_threads((int)thread::hardware_concurrency());
 }
 
 Player<char>** FourInRow_UI::setup_players() {
@@ -316,6 +250,44 @@ Player<char>** FourInRow_UI::setup_players() {
     return players;
 }
 
+ConnectN_BoardBase* FourInRow_UI::choose_board() {
+    cout << "Board:\n"
+         << "1. 6x7, connect 4 (classic)\n"
+         << "2. 7x8, connect 4\n"
+         << "3. 8x9, connect 4\n"
+         << "4. 8x9, connect 5\n"
+         << "5. Other size\n"
+         << "Choice: ";
+    int choice = 1;
+    if (!(cin >> choice)) {
+        cin.clear();
+        cin.ignore(10000, '\n');
+        choice = 1;
+    }
+
+    ConnectN_BoardBase* board = nullptr;
+    switch (choice) {
+        case 2: board = make_connect_board(7, 8, 4); break;
+        case 3: board = make_connect_board(8, 9, 4); break;
+        case 4: board = make_connect_board(8, 9, 5); break;
+        case 5: {
+            int rows = 0, columns = 0, connect = 0;
+            cout << "Rows, columns and discs in a row to win: ";
+            if (cin >> rows >> columns >> connect) {
+                // Anything bigger no longer fits a terminal
+                if (rows <= 20 && columns <= 20) board = make_connect_board(rows, columns, connect);
+            } else {
+                cin.clear();
+                cin.ignore(10000, '\n');
+            }
+            if (!board) cout << "Cannot play that size; using the classic board.\n";
+            break;
+        }
+        default: break;
+    }
+    return board ? board : new FourInRow_Board();
+}
+
 Player<char>* FourInRow_UI::create_player(string& name, char symbol, PlayerType type) {
     string type_str = (type == PlayerType::HUMAN) ? "Human" : "Computer";
     cout << "Created " << type_str << " player: " << name << " (Symbol: " << symbol << ")\n";
@@ -327,7 +299,7 @@ Move<char>* FourInRow_UI::get_move(Player<char>* player) {
         cout << "\n" << player->get_name() << "'s turn (Symbol: " << player->get_symbol() << ")\n";
         int col;
         while (true) {
-            cout << "Enter column (0-6): ";
+            cout << "Enter column (0-" << board_ptr->get_columns() - 1 << "): ";
             if (cin >> col) {
                 if (board_ptr->is_valid_move(col)) break;
                 else cout << "Invalid or full column.\n";
@@ -335,12 +307,12 @@ Move<char>* FourInRow_UI::get_move(Player<char>* player) {
                 cin.clear(); cin.ignore(10000, '\n');
             }
         }
-        return new Move<char>(0, col, player->get_symbol());
+        return move_slot.emplace(0, col, player->get_symbol());
     }
     else {
         cout << "AI " << player->get_name() << " is thinking...\n";
         int best_col = board_ptr->get_best_move(player->get_symbol());
         cout << "AI chose column " << best_col << "\n";
-        return new Move<char>(0, best_col, player->get_symbol());
+        return move_slot.emplace(0, best_col, player->get_symbol());
     }
 }
\ No newline at end of file
@@ -3,165 +3,694 @@
  * @brief Header file for the Four-in-a-Row game classes.
  *
  * This file declares the board logic and user interface for the Connect 4 game,
- * including AI implementation using Minimax with Alpha-Beta Pruning.
+ * including an AI built on the shared alpha-beta engine (Search_Classes.h).
+ *
+ * The board is a template on its rows, columns and winning-line length, so
+ * bigger Connect-N variants get the same bitboard engine with their masks,
+ * move order and window tables worked out at compile time. Sizes without a
+ * compiled instance fall back to ConnectN_DynamicBoard (see
+ * make_connect_board()).
  */
 
 #ifndef FOURINROW_CLASSES_H
 #define FOURINROW_CLASSES_H
 
 #include "BoardGame_Classes.h"
+#include "Search_Classes.h"
+#include <cstdint>
+#include <type_traits>
 #include <vector>
 #include <string>
 #include <algorithm>
 
 using namespace std;
 
+// --------------------------------------------------------------------
+// Bit masks
+// --------------------------------------------------------------------
+
 /**
- * @class FourInRow_Board
- * @brief Represents the 6x7 board for the Four-in-a-Row game.
+ * @struct ConnectN_Mask128
+ * @brief 128-bit disc mask for boards whose columns need more than 64 bits.
  *
- * Handles board updates (gravity logic), win detection across 4 directions,
- * and heuristic evaluation for the AI.
+ * Supports just what the bitboard uses: bitwise operators, shifts by less
+ * than 128 and the addition behind position keys.
+ */
+struct ConnectN_Mask128 {
+    uint64_t lo = 0; ///< Bits 0-63
+    uint64_t hi = 0; ///< Bits 64-127
+
+    constexpr ConnectN_Mask128() = default;
+    constexpr ConnectN_Mask128(uint64_t low) : lo(low) {}
+    constexpr ConnectN_Mask128(uint64_t low, uint64_t high) : lo(low), hi(high) {}
+
+    constexpr explicit operator bool() const { return (lo | hi) != 0; }
+
+    constexpr ConnectN_Mask128 operator&(const ConnectN_Mask128& o) const { return {lo & o.lo, hi & o.hi}; }
+    constexpr ConnectN_Mask128 operator|(const ConnectN_Mask128& o) const { return {lo | o.lo, hi | o.hi}; }
+    constexpr ConnectN_Mask128 operator^(const ConnectN_Mask128& o) const { return {lo ^ o.lo, hi ^ o.hi}; }
+    constexpr ConnectN_Mask128 operator~() const { return {~lo, ~hi}; }
+    ConnectN_Mask128& operator&=(const ConnectN_Mask128& o) { return *this = *this & o; }
+    ConnectN_Mask128& operator|=(const ConnectN_Mask128& o) { return *this = *this | o; }
+
+    constexpr ConnectN_Mask128 operator<<(int n) const {
+        if (n == 0) return *this;
+        if (n >= 64) return {0, lo << (n - 64)};
+        return {lo << n, (hi << n) | (lo >> (64 - n))};
+    }
+    constexpr ConnectN_Mask128 operator>>(int n) const {
+        if (n == 0) return *this;
+        if (n >= 64) return {hi >> (n - 64), 0};
+        return {(lo >> n) | (hi << (64 - n)), hi >> n};
+    }
+    constexpr ConnectN_Mask128 operator+(const ConnectN_Mask128& o) const {
+        uint64_t low = lo + o.lo;
+        return {low, hi + o.hi + (low < lo ? 1 : 0)};
+    }
+};
+
+/** @brief Discs in a mask. */
+inline int connect_mask_count(uint64_t m) { return __builtin_popcountll(m); }
+inline int connect_mask_count(const ConnectN_Mask128& m) { return connect_mask_count(m.lo) + connect_mask_count(m.hi); }
+
+/** @brief A mask folded into 64 bits, for hashing. */
+inline uint64_t connect_mask_fold(uint64_t m) { return m; }
+inline uint64_t connect_mask_fold(const ConnectN_Mask128& m) { return m.lo ^ (m.hi * 0x9E3779B97F4A7C15ull); }
+
+/** @brief One 64-bit word when the columns fit in it, two otherwise. */
+template <int ROWS, int COLUMNS>
+using ConnectN_Mask = typename conditional<COLUMNS * (ROWS + 1) <= 64, uint64_t, ConnectN_Mask128>::type;
+
+// --------------------------------------------------------------------
+// Compile-time tables
+// --------------------------------------------------------------------
+
+/**
+ * @struct ConnectN_Tables
+ * @brief Column order, windows through each cell and window scores of one
+ * board shape, built by the compiler.
+ *
+ * A window is a run of CONNECT cells in any of the four directions. Cells
+ * are numbered in the bitboard layout, `col * (ROWS + 1) + h`.
+ */
+template <int ROWS, int COLUMNS, int CONNECT>
+struct ConnectN_Tables {
+    static_assert(CONNECT >= 2 && CONNECT <= ROWS && CONNECT <= COLUMNS, "a line must fit on the board");
+
+    static const int HEIGHT = ROWS + 1;
+    static const int N_WINDOWS = ROWS * (COLUMNS - CONNECT + 1) + COLUMNS * (ROWS - CONNECT + 1) +
+                                 2 * (ROWS - CONNECT + 1) * (COLUMNS - CONNECT + 1);
+    static const int MAX_PER_CELL = 4 * CONNECT;
+
+    int order[COLUMNS] = {};                               ///< Columns, centre first
+    unsigned short through[COLUMNS * HEIGHT][MAX_PER_CELL] = {}; ///< Windows through each bit
+    int n_through[COLUMNS * HEIGHT] = {};
+    int score[CONNECT + 1][CONNECT + 1] = {};              ///< [own discs][opponent's discs]
+
+    constexpr ConnectN_Tables() {
+        for (int k = 0; k < COLUMNS; ++k)
+            order[k] = COLUMNS / 2 + ((k % 2) ? -(k + 1) / 2 : k / 2);
+
+        int n = 0;
+        for (int h = 0; h < ROWS; ++h)               // Horizontal
+            for (int c = 0; c + CONNECT <= COLUMNS; ++c) add(n, c, h, 1, 0);
+        for (int c = 0; c < COLUMNS; ++c)            // Vertical
+            for (int h = 0; h + CONNECT <= ROWS; ++h) add(n, c, h, 0, 1);
+        for (int h = 0; h + CONNECT <= ROWS; ++h)    // Diagonals, both ways
+            for (int c = 0; c + CONNECT <= COLUMNS; ++c) {
+                add(n, c, h, 1, 1);
+                add(n, c, h + CONNECT - 1, 1, -1);
+            }
+
+        for (int own = 0; own <= CONNECT; ++own)
+            for (int opp = 0; own + opp <= CONNECT; ++opp)
+                score[own][opp] = evaluate_window(own, CONNECT - own - opp, opp);
+    }
+
+    /**
+     * @brief Heuristic scoring for one window.
+     * Points are awarded for connected pieces and deducted for opponent threats.
+     * @param piece_count The AI's discs in the window.
+     * @param empty_count Empty cells in the window.
+     * @param opp_count The opponent's discs in the window.
+     * @return An integer score for this window.
+     */
+    static constexpr int evaluate_window(int piece_count, int empty_count, int opp_count) {
+        int score = 0;
+
+        if (piece_count == CONNECT) score += 100;
+        else if (piece_count == CONNECT - 1 && empty_count == 1) score += 5;
+        else if (piece_count == CONNECT - 2 && empty_count == 2) score += 2;
+
+        if (opp_count == CONNECT - 1 && empty_count == 1) score -= 4;
+
+        return score;
+    }
+
+private:
+    constexpr void add(int& n, int col, int h, int dc, int dh) {
+        for (int i = 0; i < CONNECT; ++i) {
+            int bit = (col + i * dc) * HEIGHT + h + i * dh;
+            through[bit][n_through[bit]++] = (unsigned short)n;
+        }
+        n++;
+    }
+};
+
+// --------------------------------------------------------------------
+// Bitboard
+// --------------------------------------------------------------------
+
+/**
+ * @class ConnectN_Bitboard
+ * @brief Disc masks, column heights and running heuristic of a grid.
+ *
+ * One mask of discs per player. Bit `col * HEIGHT + h` is the disc `h`
+ * places above the bottom of column `col`; the top bit of each column
+ * stays clear, so shifting a mask by 1, HEIGHT, HEIGHT - 1 or HEIGHT + 1
+ * never wraps a line into the next column. Win checks are then a few
+ * shift-and-ANDs, and drops need no scan for the landing row.
+ *
+ * It also keeps the discs of each side in each window of CONNECT cells,
+ * and the heuristic score from both sides' point of view. A drop or lift
+ * only revisits the windows through its cell, so scoring a leaf of the
+ * search is a lookup.
+ *
+ * Plain data with no pointers: copying it gives an independent position,
+ * which is what each thread of a parallel search works on.
  */
-class FourInRow_Board : public Board<char> {
+template <int ROWS_, int COLUMNS_, int CONNECT_>
+class ConnectN_Bitboard {
+public:
+    static const int ROWS = ROWS_;
+    static const int COLUMNS = COLUMNS_;
+    static const int CONNECT = CONNECT_;
+    static const int HEIGHT = ROWS + 1; ///< Bits per column: the rows and a clear sentinel bit.
+    static_assert(COLUMNS * HEIGHT <= 128, "board too large for a 128-bit mask");
+
+    typedef ConnectN_Mask<ROWS, COLUMNS> Mask;
+
+    /** @brief Index of a symbol in the masks: 'X' is 0, 'O' is 1. */
+    static int side_index(char symbol) { return symbol == 'X' ? 0 : 1; }
+
+    /**
+     * @brief True if `bits` holds CONNECT in a row in any direction.
+     *
+     * Runs are doubled in length by shift-and-AND (pairs, then pairs of
+     * pairs...), with one last step for the remainder. Shift 1 is vertical,
+     * HEIGHT horizontal, HEIGHT - 1 and HEIGHT + 1 the two diagonals.
+     */
+    static bool has_line(Mask bits) {
+        for (int shift : {1, HEIGHT, HEIGHT - 1, HEIGHT + 1}) {
+            Mask runs = bits;
+            int length = 1;
+            for (; 2 * length <= CONNECT; length *= 2) runs = runs & (runs >> (length * shift));
+            if (length < CONNECT) runs = runs & (runs >> ((CONNECT - length) * shift));
+            if (runs) return true;
+        }
+        return false;
+    }
+
+    /** @brief Puts a disc of `side` on top of column `col`. */
+    void drop(int col, int side) {
+        int bit_index = col * HEIGHT + heights[col];
+        discs[side] |= Mask(1) << bit_index;
+        heights[col]++;
+        count_disc(bit_index, col, side, 1);
+    }
+
+    /** @brief Takes the top disc, of `side`, back off column `col`. */
+    void lift(int col, int side) {
+        heights[col]--;
+        int bit_index = col * HEIGHT + heights[col];
+        discs[side] &= ~(Mask(1) << bit_index);
+        count_disc(bit_index, col, side, -1);
+    }
+
+    /** @brief True if column `col` has room. */
+    bool can_drop(int col) const { return heights[col] < ROWS; }
+
+    /** @brief Grid row (0 at the top) a disc dropped in `col` lands on. */
+    int landing_row(int col) const { return ROWS - 1 - heights[col]; }
+
+    /** @brief Discs of one side. */
+    Mask discs_of(int side) const { return discs[side]; }
+
+    /** @brief Discs on the board. */
+    int count() const { return connect_mask_count(discs[0] | discs[1]); }
+
+    /** @brief Heuristic score for `side` (see ConnectN_Board::score_position()). */
+    int score(int side) const { return running_score[side]; }
+
+    /**
+     * @brief One drop per open column, centre columns first (x is the landing row).
+     */
+    int generate_moves(char symbol, MoveList<char>& moves) const {
+        moves.clear();
+        // Centre columns first to improve Alpha-Beta pruning
+        for (int col : tables.order)
+            if (can_drop(col)) moves.add(landing_row(col), col, symbol);
+        return moves.size();
+    }
+
+    /**
+     * @brief Side-to-move discs plus all discs: a unique code for the position
+     * (the carry sets the bit above each column's top disc), then mixed so the
+     * low bits used as the table index depend on the whole board.
+     */
+    uint64_t key(int side) const {
+        uint64_t z = connect_mask_fold(discs[side] + (discs[0] | discs[1]));
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
 private:
-    char blank_symbol = '.'; ///< Symbol representing an empty slot.
+    typedef ConnectN_Tables<ROWS, COLUMNS, CONNECT> Tables;
+    static constexpr Tables tables{};
 
-    // --- Core game logic helpers ---
+    Mask discs[2] = {};                                      ///< Discs of 'X' (index 0) and 'O' (index 1).
+    int heights[COLUMNS] = {};                               ///< Discs in each column.
+    unsigned char window_discs[Tables::N_WINDOWS][2] = {};   ///< Discs of each side in each window.
+    int running_score[2] = {0, 0};                           ///< score(0) and score(1).
 
     /**
-     * @brief Checks a specific direction for 4 consecutive symbols.
-     * @param row Starting row.
-     * @param col Starting column.
-     * @param delta_row Row increment (direction).
-     * @param delta_col Column increment (direction).
-     * @param symbol The player symbol to check.
-     * @return true if 4 connected symbols are found.
+     * @brief Swaps the old score of each window through bit `bit_index` for
+     * its new one, for both sides. Factors: Center column control,
+     * horizontal/vertical/diagonal connections.
      */
-    bool check_direction(int row, int col, int delta_row, int delta_col, char symbol);
+    void count_disc(int bit_index, int col, int side, int delta) {
+        const auto& score = tables.score;
+        for (int k = 0; k < tables.n_through[bit_index]; ++k) {
+            unsigned char* n = window_discs[tables.through[bit_index][k]];
+            running_score[0] -= score[n[0]][n[1]];
+            running_score[1] -= score[n[1]][n[0]];
+            n[side] += delta;
+            running_score[0] += score[n[0]][n[1]];
+            running_score[1] += score[n[1]][n[0]];
+        }
+
+        // Center Column Preference
+        if (col == COLUMNS / 2) running_score[side] += 3 * delta;
+    }
+};
+
+/** @brief The standard 6x7 connect-4 grid. */
+typedef ConnectN_Bitboard<6, 7, 4> FourInRow_Bitboard;
+
+// --------------------------------------------------------------------
+// Boards
+// --------------------------------------------------------------------
+
+/**
+ * @class ConnectN_BoardBase
+ * @brief What the UI and tools need from a Connect-N board of any size.
+ */
+class ConnectN_BoardBase : public Board<char> {
+public:
+    ConnectN_BoardBase(int rows, int columns) : Board(rows, columns) {}
+
+    /** @brief Length of a winning line. */
+    virtual int get_connect() const = 0;
 
     /**
-     * @brief Checks if a move at (row, col) triggered a win condition.
-     * @param row Row index.
+     * @brief Validates if a move can be made in the given column.
      * @param col Column index.
-     * @param symbol Player symbol.
-     * @return true if the move completes a line of 4.
+     * @return true if valid.
      */
-    bool check_win_condition(int row, int col, char symbol);
+    virtual bool is_valid_move(int col) const = 0;
 
     /**
-     * @brief Finds the lowest available row in a specific column (Gravity logic).
-     * @param col The column index.
-     * @return The row index if available, or -1 if the column is full.
+     * @brief Determines the best move for the AI by iterative deepening
+     * within the search limits (by default half a second per move).
+     * @param ai_symbol The AI's symbol.
+     * @return The best column index, or -1 if the board is full.
      */
-    int get_next_empty_row(int col);
+    virtual int get_best_move(char ai_symbol) = 0;
 
+    /**
+     * @brief Sets the budget of later get_best_move() calls. A node budget
+     * alone keeps the computer's moves reproducible.
+     */
+    virtual void set_search_limits(const SearchLimits& new_limits) = 0;
 
     /**
-     * @brief Evaluates a window of 4 cells for scoring.
-     * @param window A vector of 4 characters representing a segment.
-     * @param piece The AI's symbol.
-     * @return An integer score for this window.
+     * @brief Sets how many threads get_best_move() searches with. More than
+     * one runs a Lazy SMP search, whose moves may vary from run to run.
      */
-    int evaluate_window(const vector<char>& window, char piece);
+    virtual void set_search_threads(int n) = 0;
+
+    /** @brief Positions visited by all searches of this board so far. */
+    virtual long long get_search_nodes() const = 0;
+};
+
+template <int ROWS, int COLUMNS, int CONNECT>
+class ConnectN_Board;
+
+/**
+ * @class ConnectN_Position
+ * @brief Search view of a ConnectN_Board for AlphaBetaSearch.
+ *
+ * Works on its own copy of the board's bitboard, so the board itself is
+ * untouched during a search and every search thread can have its own
+ * position. Leaf scores are the running heuristic for the searching side,
+ * negated on the opponent's turn.
+ */
+template <int ROWS, int COLUMNS, int CONNECT>
+class ConnectN_Position {
+public:
+    typedef char Symbol;
+    typedef ConnectN_Bitboard<ROWS, COLUMNS, CONNECT> Bitboard;
 
     /**
-     * @brief Calculates the total heuristic score of the board.
-     * @param piece The AI's symbol.
-     * @return The total score (higher is better for 'piece').
+     * @brief Starts a search on `board` with `ai_symbol` to move.
      */
-    int score_position(char piece);
+    ConnectN_Position(const ConnectN_Board<ROWS, COLUMNS, CONNECT>& board, char ai_symbol)
+        : ConnectN_Position(board.bits, ai_symbol) {}
 
     /**
-     * @brief Minimax algorithm with Alpha-Beta Pruning.
-     * @param depth Current depth of the recursion tree.
-     * @param alpha The best value that the maximizer can guarantee.
-     * @param beta The best value that the minimizer can guarantee.
-     * @param maximizingPlayer Boolean flag (true for AI, false for Opponent).
-     * @param ai_symbol The AI's character.
-     * @return The evaluation score of the board state.
+     * @brief Starts a search on a bare position with `ai_symbol` to move.
      */
-    int minimax(int depth, int alpha, int beta, bool maximizingPlayer, char ai_symbol);
+    ConnectN_Position(const Bitboard& bits, char ai_symbol)
+        : bits(bits), ai(Bitboard::side_index(ai_symbol)), side(ai), filled(bits.count()) {}
+
+    int generate_moves(MoveList<char>& moves) const {
+        return bits.generate_moves(side == 0 ? 'X' : 'O', moves);
+    }
+
+    void make_move(const Move<char>& move) {
+        bits.drop(move.get_y(), side);
+        filled++;
+        side ^= 1;
+    }
+
+    void undo_move(const Move<char>& move) {
+        side ^= 1;
+        filled--;
+        bits.lift(move.get_y(), side);
+    }
+
+    Outcome last_move_outcome() const {
+        if (Bitboard::has_line(bits.discs_of(side ^ 1))) return Outcome::WIN;
+        if (filled == ROWS * COLUMNS) return Outcome::DRAW;
+        return Outcome::ONGOING;
+    }
+
+    int evaluate() const {
+        int score = bits.score(ai);
+        return side == ai ? score : -score;
+    }
+
+    uint64_t key() const { return bits.key(side); }
+
+private:
+    Bitboard bits;
+    int ai;          ///< Side the search runs for (index into the masks).
+    int side;        ///< Side to move.
+    int filled;      ///< Discs on the board, including the search's own.
+};
+
+/** @brief Search view of the standard board. */
+typedef ConnectN_Position<6, 7, 4> FourInRow_Position;
+
+/**
+ * @class ConnectN_Board
+ * @brief A ROWS x COLUMNS board where CONNECT discs in a row win.
+ *
+ * Handles board updates (gravity logic), win detection across 4 directions,
+ * and heuristic evaluation for the AI. The char grid is what the UI shows;
+ * rules and AI run on a ConnectN_Bitboard kept in step with it.
+ */
+template <int ROWS, int COLUMNS, int CONNECT>
+class ConnectN_Board : public ConnectN_BoardBase {
+    friend class ConnectN_Position<ROWS, COLUMNS, CONNECT>;
 
 public:
+    typedef ConnectN_Bitboard<ROWS, COLUMNS, CONNECT> Bitboard;
+    typedef ConnectN_Position<ROWS, COLUMNS, CONNECT> Position;
+
+protected:
+    char blank_symbol = '.';       ///< Symbol representing an empty slot.
+    Bitboard bits;                 ///< Same discs as the grid, as bitmasks.
+    AlphaBetaSearch<Position> search; ///< Engine behind get_best_move().
+    SearchLimits limits;           ///< Budget of each get_best_move() call.
+
     /**
-     * @brief Constructor initializing a 6x7 board.
+     * @brief Returns the total heuristic score of the board, kept up to date
+     * by every drop and lift.
+     * @param piece The AI's symbol.
+     * @return The total score (higher is better for 'piece').
      */
-    FourInRow_Board();
+    int score_position(char piece) const { return bits.score(Bitboard::side_index(piece)); }
 
+public:
+    /**
+     * @brief Constructor initializing an empty board.
+     */
+    ConnectN_Board() : ConnectN_BoardBase(ROWS, COLUMNS) {
+        fill_cells(blank_symbol);
+        limits.max_depth = ROWS * COLUMNS;
+        limits.max_seconds = 0.5;
+    }
 
     /**
      * @brief Updates the board by dropping a piece into a column.
+     *
+     * The disc lands on top of the column's current height, in both the grid
+     * and the bitboard.
      * @param move The move containing the column index (y-coordinate).
      * @return true if the move is valid, false otherwise.
      */
-    bool update_board(Move<char>* move) override;
+    bool update_board(Move<char>* move) override {
+        int col = move->get_y();
+        char symbol = move->get_symbol();
+        if (!is_valid_move(col)) return false;
+
+        int row = bits.landing_row(col);
+        set_cell(row, col, symbol);
+        bits.drop(col, Bitboard::side_index(symbol));
+        n_moves++;
+        record_move(row, col);
+        return true;
+    }
 
     /**
      * @brief Checks if the player has won.
      * @param player Pointer to player.
-     * @return true if player has 4 connected.
+     * @return true if player has CONNECT connected.
      */
-    bool is_win(Player<char>* player) override;
+    bool is_win(Player<char>* player) override {
+        return Bitboard::has_line(bits.discs_of(Bitboard::side_index(player->get_symbol())));
+    }
 
     /**
      * @brief Checks if the player has lost (not strictly used in this logic).
      * @return Always false in this implementation.
      */
-    bool is_lose(Player<char>* player) override;
+    bool is_lose(Player<char>* player) override { return false; }
 
     /**
      * @brief Checks if the board is full without a winner.
      * @param player Pointer to player.
      * @return true if draw.
      */
-    bool is_draw(Player<char>* player) override;
+    bool is_draw(Player<char>* player) override { return n_moves == rows * columns; }
 
     /**
      * @brief Checks if the game is over (Win or Draw).
      * @param player Pointer to player.
      * @return true if game ended.
      */
-    bool game_is_over(Player<char>* player) override;
-
+    bool game_is_over(Player<char>* player) override { return is_win(player) || is_draw(player); }
 
     /**
-     * @brief Validates if a move can be made in the given column.
-     * @param col Column index.
-     * @return true if valid.
+     * @brief Win if a line connects through the last disc, draw when the grid is full.
      */
-    bool is_valid_move(int col);
+    Outcome evaluate_last_move(Player<char>* player) override {
+        // Only the mover's discs changed, so only they can hold a new line
+        if (is_win(player)) return Outcome::WIN;
+        if (n_moves == rows * columns) return Outcome::DRAW;
+        return Outcome::ONGOING;
+    }
 
     /**
-     * @brief Returns a list of all valid column indices.
-     * @return Vector of valid columns.
+     * @brief One drop per open column, centre columns first (x is the landing row).
      */
-    vector<int> get_valid_moves();
+    int generate_moves(char symbol, MoveList<char>& moves) const override {
+        return bits.generate_moves(symbol, moves);
+    }
+
+    int get_connect() const override { return CONNECT; }
+
+    bool is_valid_move(int col) const override {
+        return col >= 0 && col < columns && bits.can_drop(col);
+    }
 
+    int get_best_move(char ai_symbol) override {
+        Position pos(*this, ai_symbol);
+        SearchResult<char> result = search.search(pos, limits);
+        return result.found ? result.best.get_y() : -1;
+    }
+
+    void set_search_limits(const SearchLimits& new_limits) override { limits = new_limits; }
+
+    void set_search_threads(int n) override { search.set_threads(n); }
+
+    long long get_search_nodes() const override { return search.nodes_searched(); }
+
+    /** @brief The discs as bitmasks, for FourInRow_Solver and other tools. */
+    const Bitboard& get_bitboard() const { return bits; }
+};
+
+// Compiled once, in FourInRow_Classes.cpp
+extern template class ConnectN_Board<6, 7, 4>;
+extern template class ConnectN_Board<7, 8, 4>;
+extern template class ConnectN_Board<8, 9, 4>;
+extern template class ConnectN_Board<8, 9, 5>;
+
+class FourInRow_Book;
+
+/**
+ * @class FourInRow_Board
+ * @brief Represents the 6x7 board for the Four-in-a-Row game.
+ *
+ * The standard board, which also plays from the opening book.
+ */
+class FourInRow_Board : public ConnectN_Board<6, 7, 4> {
+private:
+    const FourInRow_Book* book; ///< Consulted before searching; may be null.
+
+public:
+    /**
+     * @brief Constructor initializing a 6x7 board.
+     */
+    FourInRow_Board();
 
     /**
-     * @brief Determines the best move for the AI using Minimax.
+     * @brief Determines the best move for the AI: from the opening book if
+     * the position is in it, otherwise by iterative deepening within the
+     * search limits (by default half a second per move).
      * @param ai_symbol The AI's symbol.
-     * @return The best column index.
+     * @return The best column index, or -1 if the board is full.
+     */
+    int get_best_move(char ai_symbol) override;
+
+    /**
+     * @brief Sets the opening book get_best_move() consults (nullptr for
+     * none). Boards start with FourInRow_Book::shared().
+     */
+    void set_opening_book(const FourInRow_Book* new_book) { book = new_book; }
+};
+
+class ConnectN_DynamicBoard;
+
+/**
+ * @class ConnectN_DynamicPosition
+ * @brief Search view of a ConnectN_DynamicBoard.
+ *
+ * Keeps a copy of the grid and scans it: every window for the heuristic,
+ * the lines through the last disc for a win. Several times slower than
+ * the bitboard, but any size works.
+ */
+class ConnectN_DynamicPosition {
+public:
+    typedef char Symbol;
+
+    /**
+     * @brief Starts a search on `board` with `ai_symbol` to move.
+     */
+    ConnectN_DynamicPosition(const ConnectN_DynamicBoard& board, char ai_symbol);
+
+    int generate_moves(MoveList<char>& moves) const;
+    void make_move(const Move<char>& move);
+    void undo_move(const Move<char>& move);
+    Outcome last_move_outcome() const;
+    int evaluate() const;
+    uint64_t key() const;
+
+private:
+    int rows, columns, connect;
+    vector<char> grid;     ///< Row-major, row 0 at the top; '.' when empty.
+    vector<int> heights;   ///< Discs in each column.
+    vector<int> order;     ///< Columns, centre first.
+    vector<int> history;   ///< Columns played by the search, oldest first.
+    int ai;                ///< Side the search runs for: 0 for 'X', 1 for 'O'.
+    int side;              ///< Side to move.
+    int filled;            ///< Discs on the board.
+    uint64_t hash;         ///< Zobrist hash of the grid.
+
+    char& at(int r, int c) { return grid[r * columns + c]; }
+    char at(int r, int c) const { return grid[r * columns + c]; }
+
+    /** @brief Toggles a disc of `who` on (r, c) in the hash. */
+    void toggle(int r, int c, int who);
+};
+
+/**
+ * @class ConnectN_DynamicBoard
+ * @brief A Connect-N board sized at run time.
+ *
+ * The fallback for shapes no ConnectN_Board is compiled for: the same rules
+ * and heuristic, checked by walking the char grid.
+ */
+class ConnectN_DynamicBoard : public ConnectN_BoardBase {
+    friend class ConnectN_DynamicPosition;
+
+private:
+    char blank_symbol = '.';                        ///< Symbol representing an empty slot.
+    int connect;                                    ///< Length of a winning line.
+    vector<int> heights;                            ///< Discs in each column.
+    AlphaBetaSearch<ConnectN_DynamicPosition> search; ///< Engine behind get_best_move().
+    SearchLimits limits;                            ///< Budget of each get_best_move() call.
+
+public:
+    /**
+     * @brief Creates an empty rows x columns board where `connect` in a row wins.
      */
-    int get_best_move(char ai_symbol);
+    ConnectN_DynamicBoard(int rows, int columns, int connect);
+
+    bool update_board(Move<char>* move) override;
+    bool is_win(Player<char>* player) override;
+    bool is_lose(Player<char>*) override { return false; }
+    bool is_draw(Player<char>*) override { return n_moves == rows * columns; }
+    bool game_is_over(Player<char>* player) override { return is_win(player) || is_draw(player); }
+    Outcome evaluate_last_move(Player<char>* player) override;
+    int generate_moves(char symbol, MoveList<char>& moves) const override;
+
+    int get_connect() const override { return connect; }
+    bool is_valid_move(int col) const override;
+    int get_best_move(char ai_symbol) override;
+    void set_search_limits(const SearchLimits& new_limits) override { limits = new_limits; }
+    void set_search_threads(int n) override { search.set_threads(n); }
+    long long get_search_nodes() const override { return search.nodes_searched(); }
 };
 
+/**
+ * @brief Creates an empty Connect-N board.
+ *
+ * Shapes with a compiled ConnectN_Board (6x7 connect-4, 7x8 and 8x9
+ * connect-4, 8x9 connect-5) get it; any other shape gets the slower
+ * ConnectN_DynamicBoard.
+ * @return A new board owned by the caller, or nullptr if `connect` cannot
+ * fit on the board.
+ */
+ConnectN_BoardBase* make_connect_board(int rows, int columns, int connect);
+
 
 /**
  * @class FourInRow_UI
- * @brief User Interface for Four-in-a-Row.
+ * @brief User Interface for Four-in-a-Row (and its bigger Connect-N variants).
  */
 class FourInRow_UI : public UI<char> {
 private:
-    FourInRow_Board* board_ptr; ///< Pointer to the specific board logic.
+    ConnectN_BoardBase* board_ptr; ///< Pointer to the specific board logic.
 
 public:
     /**
      * @brief Constructor.
-     * @param board Pointer to the FourInRow_Board.
+     * @param board Pointer to the board (any size).
      */
-    FourInRow_UI(FourInRow_Board* board);
+    FourInRow_UI(ConnectN_BoardBase* board);
 
     /**
      * @brief Destructor.
@@ -184,6 +713,13 @@ public:
      * @brief Sets up the two players.
      */
     Player<char>** setup_players() override;
+
+    /**
+     * @brief Asks for the board shape: the classic 6x7, one of the bigger
+     * compiled boards, or any size.
+     * @return A new board (the classic 6x7 if the answers are not usable).
+     */
+    static ConnectN_BoardBase* choose_board();
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -18,6 +18,9 @@ inf_xo_Board::inf_xo_Board() { }
  * Pushes the new move to the `moves` deque.
  * If the number of tracked moves exceeds the limit (3), the front of the deque (oldest move)
  * is popped and cleared from the board.
+ * Both the placement and the expiry go through place(), so the board hash
+ * and the marks follow the cells; the expiry order kept in `moves` is not
+ * part of them.
  *
  * @param move The move to be applied.
  * @return true if successful, false if invalid.
@@ -28,20 +31,21 @@ bool inf_xo_Board::update_board(Move<char> *move) {
     char mark = move->get_symbol();
 
     // Validation
-    if (x < 0 || x > rows || y < 0 || y > columns || board[x][y] != blank_symbol) {
+    if (x < 0 || x >= rows || y < 0 || y >= columns || cell(x, y) != blank_symbol) {
         return false;
     }
 
     // Apply new move
-    board[x][y] = mark;
+    place(x, y, mark);
     moves.push_back(make_pair(x,y));
     counter++;
+    record_move(x, y);
 
     // Logic to remove the oldest move if limit is reached.
     if (n_moves == 3) {
         auto oldest_move = moves.front();
         moves.pop_front();
-        board[oldest_move.first][oldest_move.second] = blank_symbol;
+        place(oldest_move.first, oldest_move.second, blank_symbol);
         counter = 0;
     }
 
@@ -49,7 +53,7 @@ bool inf_xo_Board::update_board(Move<char> *move) {
     if (counter == 3) {
         auto old = moves.front();
         moves.pop_front();
-        board[old.first][old.second] = blank_symbol;
+        place(old.first, old.second, blank_symbol);
         counter = 0;
     }
 
@@ -63,12 +67,18 @@ bool inf_xo_Board::is_draw(Player<char>* player) {
     return false;
 }
 
+Outcome inf_xo_Board::evaluate_last_move(Player<char>* player) {
+    // Removing the oldest mark never makes a line, so only the new mark matters
+    if (cell(last_x, last_y) == player->get_symbol() && has_line_through(last_x, last_y, 3))
+        return Outcome::WIN;
+    if (!check_available_moves()) return Outcome::DRAW;
+    return Outcome::ONGOING;
+}
+
 bool inf_xo_Board::check_available_moves() {
-    for (auto& row : board) {
-        for (auto& cell : row) {
-            if (cell == blank_symbol) {
-                return true;
-            }
+    for (char c : board) {
+        if (c == blank_symbol) {
+            return true;
         }
     }
     return false;
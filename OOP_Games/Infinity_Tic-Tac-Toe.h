@@ -49,6 +49,17 @@ public:
      */
     bool is_draw(Player<char> *) override;
 
+    /**
+     * @brief Win if a line runs through the last mark, draw if no cell is free.
+     */
+    Outcome evaluate_last_move(Player<char>* player) override;
+
+    /**
+     * @brief Marks expire here, so the standard game's table does not apply.
+     * @return Always false.
+     */
+    bool get_best_move(char, Move<char>&, int* = nullptr) const override { return false; }
+
     /**
      * @brief Checks if there are any empty cells left.
      * @return true if moves are available.
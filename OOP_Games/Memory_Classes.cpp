@@ -23,8 +23,8 @@ void Memory_UI::clear_screen() {
 
 
 Memory_Board::Memory_Board() : Board<char>(3, 3) {
-    // Initialize the real underlying board
-    real_board = vector<vector<char>>(3, vector<char>(3, blank_symbol));
+    // The inherited cells hold the real values; only the views are masked
+    fill_cells(blank_symbol);
 }
 
 bool Memory_Board::update_board(Move<char>* move) {
@@ -33,44 +33,34 @@ bool Memory_Board::update_board(Move<char>* move) {
     char mark = move->get_symbol();
 
     // Validate against boundaries and the REAL board state
-    if (x < 0 || x >= 3 || y < 0 || y >= 3 || real_board[x][y] != blank_symbol) {
+    if (x < 0 || x >= 3 || y < 0 || y >= 3 || cell(x, y) != blank_symbol) {
         return false;
     }
 
     n_moves++;
-    real_board[x][y] = toupper(mark);
+    set_cell(x, y, toupper(mark));
+    record_move(x, y);
     return true;
 }
 
-vector<vector<char>> Memory_Board::get_board_matrix() const {
-    vector<vector<char>> hidden_board = vector<vector<char>>(3, vector<char>(3, blank_symbol));
+char Memory_Board::mask_hidden(const void*, int, int, const char& value) {
+    return value == blank_symbol ? value : hidden_symbol; // Hide occupied cells
+}
 
-    for (int i = 0; i < 3; ++i) {
-        for (int j = 0; j < 3; ++j) {
-            if (real_board[i][j] != blank_symbol) {
-                hidden_board[i][j] = hidden_symbol; // Hide occupied cells
-            }
-        }
-    }
-    return hidden_board;
+char Memory_Board::mask_reveal(const void* owner, int r, int c, const char& value) {
+    const Reveal* reveal = static_cast<const Reveal*>(owner);
+    if (value == blank_symbol) return value;
+    if (r == reveal->x && c == reveal->y) return reveal->symbol; // Reveal last play
+    return hidden_symbol;                                        // Keep others hidden
 }
 
-vector<vector<char>> Memory_Board::get_move_display_board(int move_x, int move_y, char symbol) const {
-    // Generate view revealing ONLY the current move
-    vector<vector<char>> move_board = vector<vector<char>>(3, vector<char>(3, blank_symbol));
+BoardView<char> Memory_Board::get_board_view() const {
+    return BoardView<char>(board.data(), rows, columns, &Memory_Board::mask_hidden, this);
+}
 
-    for (int i = 0; i < 3; ++i) {
-        for (int j = 0; j < 3; ++j) {
-            if (real_board[i][j] != blank_symbol) {
-                if (i == move_x && j == move_y) {
-                    move_board[i][j] = symbol;      // Reveal last play
-                } else {
-                    move_board[i][j] = hidden_symbol; // Keep others hidden
-                }
-            }
-        }
-    }
-    return move_board;
+BoardView<char> Memory_Board::get_move_display_board(const Reveal& reveal) const {
+    // View revealing ONLY the current move
+    return BoardView<char>(board.data(), rows, columns, &Memory_Board::mask_reveal, &reveal);
 }
 
 bool Memory_Board::is_win(Player<char>* player) {
@@ -81,12 +71,12 @@ bool Memory_Board::is_win(Player<char>* player) {
 
     // Check on the REAL board
     for (int i = 0; i < 3; ++i) {
-        if ((all_equal(real_board[i][0], real_board[i][1], real_board[i][2]) && real_board[i][0] == sym) ||
-            (all_equal(real_board[0][i], real_board[1][i], real_board[2][i]) && real_board[0][i] == sym))
+        if ((all_equal(cell(i, 0), cell(i, 1), cell(i, 2)) && cell(i, 0) == sym) ||
+            (all_equal(cell(0, i), cell(1, i), cell(2, i)) && cell(0, i) == sym))
             return true;
     }
-    if ((all_equal(real_board[0][0], real_board[1][1], real_board[2][2]) && real_board[1][1] == sym) ||
-        (all_equal(real_board[0][2], real_board[1][1], real_board[2][0]) && real_board[1][1] == sym))
+    if ((all_equal(cell(0, 0), cell(1, 1), cell(2, 2)) && cell(1, 1) == sym) ||
+        (all_equal(cell(0, 2), cell(1, 1), cell(2, 0)) && cell(1, 1) == sym))
         return true;
 
     return false;
@@ -100,6 +90,18 @@ bool Memory_Board::game_is_over(Player<char>* player) {
     return is_win(player) || is_draw(player);
 }
 
+int Memory_Board::generate_moves(char symbol, MoveList<char>& moves) const {
+    return generate_placements(blank_symbol, symbol, moves);
+}
+
+Outcome Memory_Board::evaluate_last_move(Player<char>* player) {
+    // Checked on the REAL cells, through the last move only
+    if (cell(last_x, last_y) == player->get_symbol() && has_line_through(last_x, last_y, 3))
+        return Outcome::WIN;
+    if (n_moves == 9) return Outcome::DRAW;
+    return Outcome::ONGOING;
+}
+
 // --- Memory_UI Implementation ---
 
 Memory_UI::Memory_UI(Memory_Board* board) : UI<char>("Memory Tic-Tac-Toe - Test Your Memory!", 3), memory_board(board) {}
@@ -110,15 +112,15 @@ Player<char>* Memory_UI::create_player(string& name, char symbol, PlayerType typ
     return new Player<char>(name, symbol, type);
 }
 
-void Memory_UI::display_board_matrix(const vector<vector<char>>& matrix) const {
-    UI<char>::display_board_matrix(matrix);
+void Memory_UI::display_board_matrix(const BoardView<char>& view) const {
+    UI<char>::display_board_matrix(view);
 }
 
 Move<char>* Memory_UI::get_move(Player<char>* player) {
     int x, y;
 
     cout << "\nCurrent board (all positions hidden):\n";
-    display_board_matrix(memory_board->get_board_matrix());
+    display_board_matrix(memory_board->get_board_view());
 
     if (player->get_type() == PlayerType::HUMAN) {
         cout << "\n" << player->get_name() << " (" << player->get_symbol()
@@ -129,14 +131,14 @@ Move<char>* Memory_UI::get_move(Player<char>* player) {
         do {
             x = rand() % 3;
             y = rand() % 3;
-        } while (memory_board->get_board_matrix()[x][y] != '.');
+        } while (memory_board->get_cell(x, y) != '.');
         cout << "\nComputer " << player->get_name() << " chose position (" << x << ", " << y << ")\n";
     }
-    return new Move<char>(x, y, player->get_symbol());
+    return move_slot.emplace(x, y, player->get_symbol());
 }
 
 void Memory_UI::run_game(Player<char>* players[2]) {
-    display_board_matrix(memory_board->get_board_matrix());
+    display_board_matrix(memory_board->get_board_view());
     Player<char>* currentPlayer = players[0];
 
     while (true) {
@@ -148,26 +150,25 @@ void Memory_UI::run_game(Player<char>* players[2]) {
             // Keep asking until valid move
             while (!memory_board->update_board(move)) {
                 cout << "Invalid move! Try again.\n";
-                delete move;
                 move = get_move(currentPlayer);
             }
 
             // Briefly show what happened
             cout << "\nYour move was placed at (" << move->get_x() << ", " << move->get_y() << "):\n";
-            display_board_matrix(memory_board->get_move_display_board(move->get_x(), move->get_y(), currentPlayer->get_symbol()));
+            Memory_Board::Reveal reveal = {move->get_x(), move->get_y(), currentPlayer->get_symbol()};
+            display_board_matrix(memory_board->get_move_display_board(reveal));
 
             cout << "Remember your move...\n\n";
             this_thread::sleep_for(chrono::milliseconds(1100)); // Wait 1.1 seconds
 
             clear_screen();
 
-            delete move;
-
-            if (memory_board->is_win(currentPlayer)) {
+            Outcome outcome = memory_board->get_outcome(currentPlayer);
+            if (outcome == Outcome::WIN) {
                 display_message(currentPlayer->get_name() + " wins!");
                 return;
             }
-            if (memory_board->is_draw(currentPlayer)) {
+            if (outcome == Outcome::DRAW) {
                 display_message("Draw!");
                 return;
             }
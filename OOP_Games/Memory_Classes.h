@@ -16,12 +16,31 @@ using namespace std;
 /**
  * @class Memory_Board
  * @brief A 3x3 Board that manages hidden vs. real states.
+ *
+ * The inherited cells store the actual values ('X', 'O'); the matrices handed
+ * out for display are masked so players never see them.
  */
 class Memory_Board : public Board<char> {
+public:
+    /**
+     * @struct Reveal
+     * @brief The one cell get_move_display_board() shows.
+     */
+    struct Reveal {
+        int x;       ///< Row of the move.
+        int y;       ///< Column of the move.
+        char symbol; ///< Symbol shown at (x, y).
+    };
+
 private:
-    char blank_symbol = '.';
-    char hidden_symbol = '?';       ///< Symbol used to mask occupied cells.
-    vector<vector<char>> real_board; ///< Stores the actual values ('X', 'O') which are hidden from view.
+    static constexpr char blank_symbol = '.';
+    static constexpr char hidden_symbol = '?'; ///< Symbol used to mask occupied cells.
+
+    /** @brief View mask: occupied cells become '?'. */
+    static char mask_hidden(const void* owner, int r, int c, const char& value);
+
+    /** @brief View mask: only the Reveal cell `owner` is shown, other occupied cells become '?'. */
+    static char mask_reveal(const void* owner, int r, int c, const char& value);
 
 public:
     /**
@@ -64,21 +83,30 @@ public:
     bool game_is_over(Player<char>* player);
 
     /**
-     * @brief Returns a masked version of the board.
-     * Occupied cells are shown as '?', empty cells as '.'.
-     * @return Matrix of characters.
+     * @brief Win if a line runs through the last move, draw once the board is full.
+     */
+    Outcome evaluate_last_move(Player<char>* player) override;
+
+    /**
+     * @brief Every empty cell of the real board.
+     */
+    int generate_moves(char symbol, MoveList<char>& moves) const override;
+
+    /**
+     * @brief Returns a masked view of the board.
+     * Occupied cells are shown as '?', empty cells as '.'. The mask is applied
+     * lazily as cells are read, so no hidden copy of the board is built.
+     * @return Read-only masked view.
      */
-    vector<vector<char>> get_board_matrix() const;
+    BoardView<char> get_board_view() const override;
 
     /**
      * @brief Returns a special view of the board for the "reveal" phase.
      * Shows only the specific symbol just played, hiding everything else with '?'.
-     * @param move_x The row of the current move.
-     * @param move_y The column of the current move.
-     * @param symbol The symbol to reveal at (move_x, move_y).
-     * @return Matrix of characters.
+     * @param reveal The move to show; the view reads it, so it must outlive the view.
+     * @return Read-only masked view.
      */
-    vector<vector<char>> get_move_display_board(int move_x, int move_y, char symbol) const;
+    BoardView<char> get_move_display_board(const Reveal& reveal) const;
 };
 
 /**
@@ -107,7 +135,7 @@ public:
      */
     virtual Move<char>* get_move(Player<char>* player);
 
-    virtual void display_board_matrix(const vector<vector<char>>& matrix) const;
+    virtual void display_board_matrix(const BoardView<char>& view) const;
 
     /**
      * @brief Custom game loop manager.
@@ -7,24 +7,119 @@
 #include <iostream>
 #include <cstdlib>
 #include <ctime>
+#include <cstdint>
 #include <algorithm>
-#include <limits>
+#include <memory>
 
 using namespace std;
 
 const char Misere_Board::blank_symbol = ' ';
 
+// -----------------------------------------------------------------------------
+// Board shapes
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief The K-cell lines of an N x N board, and its symmetries.
+ * Masks use bit r * N + c.
+ */
+struct Misere_Geometry {
+    int size = 0;
+    vector<uint64_t> lines;
+    vector<vector<uint64_t>> through; ///< Lines through each cell
+    vector<int> image[8];             ///< image[t][i]: where cell i goes under symmetry t
+    vector<int> source[8];            ///< source[t][i]: the cell that goes to i
+    vector<int> centre_first;         ///< Cells by distance from the centre
+    vector<uint64_t> keys[2];         ///< Zobrist keys of X and O on each cell
+
+    Misere_Geometry(int n, int k) : size(n), through(n * n) {
+        static const int dirs[4][2] = {{0, 1}, {1, 0}, {1, 1}, {1, -1}};
+        for (const auto& d : dirs)
+            for (int r = 0; r < n; ++r)
+                for (int c = 0; c < n; ++c) {
+                    int r_end = r + (k - 1) * d[0], c_end = c + (k - 1) * d[1];
+                    if (r_end < 0 || r_end >= n || c_end < 0 || c_end >= n) continue;
+                    uint64_t mask = 0;
+                    for (int i = 0; i < k; ++i) mask |= 1ull << ((r + i * d[0]) * n + (c + i * d[1]));
+                    lines.push_back(mask);
+                    for (int i = 0; i < n * n; ++i)
+                        if (mask >> i & 1) through[i].push_back(mask);
+                }
+
+        for (int i = 0; i < n * n; ++i) centre_first.push_back(i);
+        // Doubled coordinates keep the centre of an even board on the grid
+        auto distance = [n](int i) {
+            int dr = 2 * (i / n) - (n - 1), dc = 2 * (i % n) - (n - 1);
+            return dr * dr + dc * dc;
+        };
+        stable_sort(centre_first.begin(), centre_first.end(), [&](int a, int b) { return distance(a) < distance(b); });
+
+        for (int t = 0; t < 8; ++t) {
+            image[t].resize(n * n);
+            source[t].resize(n * n);
+            for (int i = 0; i < n * n; ++i) {
+                int r = i / n, c = i % n;
+                if (t & 4) swap(r, c); // Transpose
+                if (t & 1) r = n - 1 - r;
+                if (t & 2) c = n - 1 - c;
+                image[t][i] = r * n + c;
+                source[t][r * n + c] = i;
+            }
+        }
+
+        uint64_t z = 0x5EED5EED5EED5EEDull;
+        for (auto& side : keys)
+            for (int i = 0; i < n * n; ++i) {
+                z += 0x9E3779B97F4A7C15ull; // SplitMix64
+                uint64_t x = z;
+                x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+                x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+                side.push_back(x ^ (x >> 31));
+            }
+    }
+
+    /** @brief The shared tables of a board shape, built on first use. */
+    static const Misere_Geometry& of(int n, int k) {
+        static const vector<unique_ptr<Misere_Geometry>> shapes = [] {
+            vector<unique_ptr<Misere_Geometry>> all;
+            for (int size = Misere_Board::MIN_SIZE; size <= Misere_Board::MAX_SIZE; ++size)
+                for (int length = Misere_Board::MIN_SIZE; length <= Misere_Board::MAX_SIZE; ++length)
+                    all.emplace_back(length <= size ? new Misere_Geometry(size, length) : nullptr);
+            return all;
+        }();
+        const int span = Misere_Board::MAX_SIZE - Misere_Board::MIN_SIZE + 1;
+        return *shapes[(n - Misere_Board::MIN_SIZE) * span + (k - Misere_Board::MIN_SIZE)];
+    }
+};
+
+namespace {
+
+int side_index(char symbol) { return symbol == 'X' ? 0 : 1; }
+
+} // namespace
+
 // -----------------------------------------------------------------------------
 // Misere_Board Implementation
 // -----------------------------------------------------------------------------
 
-Misere_Board::Misere_Board() : Board<char>(3, 3) {
-    for (int i = 0; i < rows; ++i)
-        for (int j = 0; j < columns; ++j)
-            board[i][j] = blank_symbol;
+Misere_Board::Misere_Board(int size, int line_length)
+    : Board<char>(min(max(size, MIN_SIZE), MAX_SIZE), min(max(size, MIN_SIZE), MAX_SIZE)),
+      line_length(min(max(line_length, MIN_SIZE), rows)),
+      geometry(&Misere_Geometry::of(rows, this->line_length)) {
+    fill_cells(blank_symbol);
     n_moves = 0;
 }
 
+void Misere_Board::place(int r, int c, char symbol) {
+    int i = r * columns + c;
+    char old = cell(r, c);
+    char changed = (symbol == blank_symbol) ? old : symbol;
+    int side = side_index(changed);
+    marks[side] ^= 1ull << i;
+    for (int t = 0; t < 8; ++t) symmetric_hash[t] ^= geometry->keys[side][geometry->image[t][i]];
+    set_cell(r, c, symbol);
+}
+
 bool Misere_Board::update_board(Move<char>* move) {
     int r = move->get_x();
     int c = move->get_y();
@@ -34,25 +129,20 @@ bool Misere_Board::update_board(Move<char>* move) {
         cout << "Invalid move: (" << r << "," << c << ") out of bounds.\n";
         return false;
     }
-    if (board[r][c] != blank_symbol) {
+    if (cell(r, c) != blank_symbol) {
         cout << "Invalid move: Cell (" << r << "," << c << ") is occupied.\n";
         return false;
     }
-    board[r][c] = sym;
+    place(r, c, sym);
     ++n_moves;
+    record_move(r, c);
     return true;
 }
 
-bool Misere_Board::player_has_three(char symbol) const {
-    // Check rows
-    for (int i = 0; i < 3; ++i)
-        if (board[i][0] == symbol && board[i][1] == symbol && board[i][2] == symbol) return true;
-    // Check cols
-    for (int j = 0; j < 3; ++j)
-        if (board[0][j] == symbol && board[1][j] == symbol && board[2][j] == symbol) return true;
-    // Check diagonals
-    if (board[0][0] == symbol && board[1][1] == symbol && board[2][2] == symbol) return true;
-    if (board[0][2] == symbol && board[1][1] == symbol && board[2][0] == symbol) return true;
+bool Misere_Board::player_has_line(char symbol) const {
+    uint64_t mine = marks[side_index(symbol)];
+    for (uint64_t line : geometry->lines)
+        if ((mine & line) == line) return true;
     return false;
 }
 
@@ -63,13 +153,13 @@ bool Misere_Board::is_win(Player<char>* /*player*/) {
 
 bool Misere_Board::is_lose(Player<char>* player) {
     if (!player) return false;
-    return player_has_three(player->get_symbol());
+    return player_has_line(player->get_symbol());
 }
 
 bool Misere_Board::is_draw(Player<char>* /*player*/) {
-    // If board is full and NO ONE has 3-in-a-row, it's a draw.
+    // If board is full and NO ONE has K in a row, it's a draw.
     if (n_moves < rows * columns) return false;
-    if (!player_has_three('X') && !player_has_three('O')) return true;
+    if (!player_has_line('X') && !player_has_line('O')) return true;
     return false;
 }
 
@@ -77,181 +167,237 @@ bool Misere_Board::game_is_over(Player<char>* player) {
     return is_lose(player) || is_draw(player);
 }
 
+Outcome Misere_Board::evaluate_last_move(Player<char>* player) {
+    if (cell(last_x, last_y) == player->get_symbol()) {
+        uint64_t mine = marks[side_index(player->get_symbol())];
+        for (uint64_t line : geometry->through[last_x * columns + last_y])
+            if ((mine & line) == line) return Outcome::LOSE;
+    }
+    if (n_moves == rows * columns) return Outcome::DRAW;
+    return Outcome::ONGOING;
+}
+
 
 bool Misere_Board::cell_empty(int r, int c) const {
-    return board[r][c] == blank_symbol;
+    return r >= 0 && r < rows && c >= 0 && c < columns && cell(r, c) == blank_symbol;
 }
 
-vector<pair<int,int>> Misere_Board::get_empty_cells() const {
-    vector<pair<int,int>> empties;
-    for (int r = 0; r < rows; ++r)
-        for (int c = 0; c < columns; ++c)
-            if (board[r][c] == blank_symbol)
-                empties.emplace_back(r,c);
-    return empties;
+int Misere_Board::generate_moves(char symbol, MoveList<char>& moves) const {
+    return generate_placements(blank_symbol, symbol, moves);
+}
+
+int Misere_Board::canonical_symmetry() const {
+    int best = 0;
+    for (int t = 1; t < 8; ++t)
+        if (symmetric_hash[t] < symmetric_hash[best]) best = t;
+    return best;
+}
+
+uint64_t Misere_Board::get_canonical_hash() const {
+    return symmetric_hash[canonical_symmetry()];
+}
+
+uint64_t Misere_Board::losing_cells(char symbol) const {
+    uint64_t mine = marks[side_index(symbol)], theirs = marks[1 - side_index(symbol)];
+    uint64_t cells = 0;
+    for (uint64_t line : geometry->lines) {
+        uint64_t missing = line & ~mine;
+        if (missing && !(missing & (missing - 1)) && !(line & theirs)) cells |= missing;
+    }
+    return cells;
+}
+
+int Misere_Board::generate_canonical_moves(char symbol, MoveList<char>& moves) const {
+    const vector<int>& source = geometry->source[canonical_symmetry()];
+    uint64_t losing = losing_cells(symbol);
+    moves.clear();
+    for (int pass = 0; pass < 2; ++pass)
+        for (int j : geometry->centre_first) {
+            int i = source[j];
+            if (cell(i / columns, i % columns) == blank_symbol && bool(losing >> i & 1) == (pass == 1))
+                moves.add(i / columns, i % columns, symbol);
+        }
+    return moves.size();
+}
+
+int Misere_Board::evaluate(char symbol) const {
+    int me = side_index(symbol);
+    uint64_t empty = ~(marks[0] | marks[1]);
+    int score = 16 * (__builtin_popcountll(losing_cells(symbol == 'X' ? 'O' : 'X') & empty) -
+                      __builtin_popcountll(losing_cells(symbol) & empty));
+    for (uint64_t line : geometry->lines) {
+        int mine = __builtin_popcountll(line & marks[me]), theirs = __builtin_popcountll(line & marks[1 - me]);
+        if (theirs == 0) score -= mine * mine;
+        if (mine == 0) score += theirs * theirs;
+    }
+    return score;
 }
 
 bool Misere_Board::make_temp_move(int r, int c, char symbol) {
     if (r < 0 || r >= rows || c < 0 || c >= columns) return false;
-    if (board[r][c] != blank_symbol) return false;
-    board[r][c] = symbol;
+    if (cell(r, c) != blank_symbol) return false;
+    place(r, c, symbol);
     ++n_moves;
     return true;
 }
 
 void Misere_Board::undo_temp_move(int r, int c) {
     if (r < 0 || r >= rows || c < 0 || c >= columns) return;
-    if (board[r][c] != blank_symbol) {
-        board[r][c] = blank_symbol;
+    if (cell(r, c) != blank_symbol) {
+        place(r, c, blank_symbol);
         --n_moves;
     }
 }
 
-bool Misere_Board::placement_creates_three(int r, int c, char symbol) const {
-    // Temporarily checks if a move at (r,c) completes a line for 'symbol'
-    // Check row r
-    bool row_three = true;
-    for (int j = 0; j < 3; ++j) {
-        char val = (j == c) ? symbol : board[r][j];
-        if (val != symbol) { row_three = false; break; }
-    }
-    if (row_three) return true;
+bool Misere_Board::placement_creates_line(int r, int c, char symbol) const {
+    // Checks if a move at (r,c) would complete a line for 'symbol'
+    int i = r * columns + c;
+    uint64_t after = marks[side_index(symbol)] | (1ull << i);
+    for (uint64_t line : geometry->through[i])
+        if ((after & line) == line) return true;
+    return false;
+}
 
-    // Check column c
-    bool col_three = true;
-    for (int i = 0; i < 3; ++i) {
-        char val = (i == r) ? symbol : board[i][c];
-        if (val != symbol) { col_three = false; break; }
-    }
-    if (col_three) return true;
-
-    // Diagonals
-    if (r == c) {
-        bool diag = true;
-        for (int i = 0; i < 3; ++i) {
-            char val = (i == r) ? symbol : board[i][i];
-            if (val != symbol) { diag = false; break; }
-        }
-        if (diag) return true;
+// -----------------------------------------------------------------------------
+// Solved positions
+// -----------------------------------------------------------------------------
+
+namespace {
+
+/**
+ * A position is coded in base 3 from the side to move's point of view:
+ * digit i (cell r * 3 + c) is 0 for empty, 1 for the side to move, 2 for
+ * the opponent.
+ */
+constexpr int POSITIONS = 19683; // 3^9
+constexpr int POW3[9] = {1, 3, 9, 27, 81, 243, 729, 2187, 6561};
+constexpr int LINES[8] = {0007, 0070, 0700, 0111, 0222, 0444, 0421, 0124}; // Cell bitmasks
+constexpr int ORDER[9] = {4, 0, 2, 6, 8, 1, 3, 5, 7}; // Centre, corners, edges
+
+/**
+ * An entry packs `SOLVED | (score + 16) << 4 | cell`. A score is for the
+ * side to move: 10 - n if the opponent completes a line when n cells are
+ * full (sooner is better), minus that if we do, 0 for a draw.
+ */
+constexpr uint16_t SOLVED = 0x8000;
+
+struct MisereTable {
+    uint16_t entry[POSITIONS] = {};
+};
+
+constexpr bool completes_line(int cells, int cell) {
+    for (int line : LINES)
+        if ((line >> cell & 1) && (cells | (1 << cell)) == (cells | line)) return true;
+    return false;
+}
+
+constexpr int solve(MisereTable& table, int code) {
+    if (table.entry[code] & SOLVED) return ((table.entry[code] >> 4) & 0x1F) - 16;
+
+    int mine = 0, filled = 0, swapped = 0; // swapped: the same position, opponent to move
+    for (int i = 0; i < 9; ++i) {
+        int digit = code / POW3[i] % 3;
+        if (digit != 0) ++filled;
+        if (digit == 1) mine |= 1 << i;
+        swapped += (digit == 0 ? 0 : 3 - digit) * POW3[i];
     }
-    if (r + c == 2) {
-        bool diag = true;
-        for (int i = 0; i < 3; ++i) {
-            int j = 2 - i;
-            char val = (i == r && j == c) ? symbol : board[i][j];
-            if (val != symbol) { diag = false; break; }
+
+    int best = -100, best_cell = 0;
+    for (int cell : ORDER) {
+        if (code / POW3[cell] % 3 != 0) continue;
+        int score = 0;
+        if (completes_line(mine, cell)) score = -(10 - (filled + 1));
+        else if (filled == 8) score = 0;
+        else score = -solve(table, swapped + 2 * POW3[cell]);
+        if (score > best) {
+            best = score;
+            best_cell = cell;
         }
-        if (diag) return true;
     }
-    return false;
+    table.entry[code] = uint16_t(SOLVED | (best + 16) << 4 | best_cell);
+    return best;
 }
 
+/** @brief Every position reachable from the empty board, solved. */
+constexpr MisereTable solve_all() {
+    MisereTable table;
+    solve(table, 0);
+    return table;
+}
+
+constexpr MisereTable MISERE_TABLE = solve_all();
+
+static_assert(((MISERE_TABLE.entry[0] >> 4) & 0x1F) == 16, "Misere 3x3 is a draw with perfect play");
+
+} // namespace
+
 // -----------------------------------------------------------------------------
 // Misere_AIPlayer Implementation
 // -----------------------------------------------------------------------------
 
 Misere_AIPlayer::Misere_AIPlayer(const string& name, char symbol)
-    : Player<char>(name, symbol, PlayerType::AI) {}
-
-Move<char>* Misere_AIPlayer::get_smart_move(Misere_Board* board, char opponent_symbol) {
-    cout << "AI " << get_name() << " is thinking (full backtracking)...\n";
-
-    vector<pair<int,int>> empties = board->get_empty_cells();
-    if (empties.empty()) return new Move<char>(0,0,get_symbol());
-
-    int best_score = -2;
-    vector<pair<int,int>> best_moves;
-
-    for (auto mv : empties) {
-        int r = mv.first, c = mv.second;
-
-        // 1. Immediate Suicidal Check
-        // If playing here makes ME create 3-in-a-row, I lose instantly. Score = -1 (Bad).
-        board->make_temp_move(r, c, get_symbol());
-        if (board->placement_creates_three(r, c, get_symbol())) {
-            board->undo_temp_move(r, c);
-            if (-1 > best_score) {
-                best_score = -1;
-                best_moves.clear();
-                best_moves.push_back(mv);
-            } else if (-1 == best_score) {
-                best_moves.push_back(mv);
-            }
-            continue;
-        }
+    : Player<char>(name, symbol, PlayerType::AI) {
+    limits.max_seconds = 0.5;
+}
 
-        // 2. Otherwise, see if this leads to a win down the line
-        int score = backtrack_minimax(board, opponent_symbol);
-        board->undo_temp_move(r, c);
+Move<char> Misere_AIPlayer::get_smart_move(Misere_Board* board, char opponent_symbol) {
+    int best_score = 0;
+    Move<char> move = choose_move(board, opponent_symbol, &best_score);
+    cout << "AI " << get_name() << " selected (" << move.get_x() << "," << move.get_y() << ") with score " << best_score << "\n";
+    return move;
+}
 
-        if (score > best_score) {
-            best_score = score;
-            best_moves.clear();
-            best_moves.push_back(mv);
-        } else if (score == best_score) {
-            best_moves.push_back(mv);
-        }
+Move<char> Misere_AIPlayer::choose_move(Misere_Board* board, char opponent_symbol, int* score_out) {
+    if (board->get_size() != 3) {
+        Misere_Position pos(board, get_symbol());
+        SearchResult<char> result = search.search(pos, limits);
+        if (!result.found) return Move<char>(0, 0, get_symbol());
+        if (score_out) *score_out = search_is_decisive(result.score) ? (result.score > 0) - (result.score < 0) : 0;
+        return Move<char>(result.best.get_x(), result.best.get_y(), get_symbol());
     }
 
-    pair<int,int> chosen = tiebreak_choose(best_moves);
-    cout << "AI " << get_name() << " selected (" << chosen.first << "," << chosen.second << ") with score " << best_score << "\n";
-    return new Move<char>(chosen.first, chosen.second, get_symbol());
-}
-
-int Misere_AIPlayer::backtrack_minimax(Misere_Board* board, char current_symbol) {
-    auto empties = board->get_empty_cells();
-    if (empties.empty()) return 0; // Draw
-
-    bool is_ai_turn = (current_symbol == this->get_symbol());
-    int best = is_ai_turn ? -2 : 2;
-
-    for (auto mv : empties) {
-        int r = mv.first, c = mv.second;
-        board->make_temp_move(r, c, current_symbol);
-
-        // Does this move force the current player to lose?
-        if (board->placement_creates_three(r, c, current_symbol)) {
-            // Mover loses.
-            // If AI moved and lost -> Outcome -1
-            // If Opponent moved and lost -> Outcome +1
-            int outcome = (current_symbol == this->get_symbol()) ? -1 : 1;
-            
-            board->undo_temp_move(r, c);
-
-            if (is_ai_turn) best = max(best, outcome);
-            else best = min(best, outcome);
-            
-            // Pruning
-            if (is_ai_turn && best == 1) return 1;
-            if (!is_ai_turn && best == -1) return -1;
-            continue;
-        }
+    int code = 0, first_empty = -1;
+    for (int i = 0; i < 9; ++i) {
+        char c = board->get_cell(i / 3, i % 3);
+        if (c == get_symbol()) code += POW3[i];
+        else if (c == opponent_symbol) code += 2 * POW3[i];
+        else if (first_empty < 0) first_empty = i;
+    }
+    if (first_empty < 0) return Move<char>(0, 0, get_symbol());
+
+    // Positions off the normal course of a game (e.g. already lost) are not in the table
+    uint16_t entry = MISERE_TABLE.entry[code];
+    int cell = (entry & SOLVED) ? (entry & 0xF) : first_empty;
+    int score = (entry & SOLVED) ? ((entry >> 4) & 0x1F) - 16 : 0;
+    if (score_out) *score_out = (score > 0) - (score < 0);
+    return Move<char>(cell / 3, cell % 3, get_symbol());
+}
 
-        // Recurse
-        char next = (current_symbol == 'X') ? 'O' : 'X';
-        int score = backtrack_minimax(board, next);
-        board->undo_temp_move(r, c);
+// -----------------------------------------------------------------------------
+// Misere_Position Implementation
+// -----------------------------------------------------------------------------
 
-        if (is_ai_turn) best = max(best, score);
-        else best = min(best, score);
+Misere_Position::Misere_Position(Misere_Board* board, char symbol) : board(board), side(symbol) {}
 
-        if (is_ai_turn && best == 1) return 1;
-        if (!is_ai_turn && best == -1) return -1;
-    }
+void Misere_Position::make_move(const Move<char>& move) {
+    completed_line = board->placement_creates_line(move.get_x(), move.get_y(), side);
+    board->make_temp_move(move.get_x(), move.get_y(), side);
+    side = (side == 'X') ? 'O' : 'X';
+}
 
-    if (best == -2 || best == 2) return 0;
-    return best;
+void Misere_Position::undo_move(const Move<char>& move) {
+    board->undo_temp_move(move.get_x(), move.get_y());
+    side = (side == 'X') ? 'O' : 'X';
 }
 
-pair<int,int> Misere_AIPlayer::tiebreak_choose(const vector<pair<int,int>>& choices) {
-    pair<int,int> center = {1,1};
-    for (auto p : choices) if (p == center) return p; // Prefer Center
+Outcome Misere_Position::last_move_outcome() const {
+    if (completed_line) return Outcome::LOSE;
+    if (board->get_n_moves() == board->get_size() * board->get_size()) return Outcome::DRAW;
+    return Outcome::ONGOING;
+}
 
-    vector<pair<int,int>> corners = { {0,0}, {0,2}, {2,0}, {2,2} };
-    for (auto c : corners) {
-        for (auto p : choices) if (p == c) return p; // Prefer Corners
-    }
-    return choices.front();
+uint64_t Misere_Position::key() const {
+    return board->get_canonical_hash() ^ search_side_key(side);
 }
 
 // -----------------------------------------------------------------------------
@@ -262,6 +408,26 @@ Misere_UI::Misere_UI(Misere_Board* board) : UI<char>("Welcome to Misere Tic-Tac-
     srand((unsigned)time(nullptr));
 }
 
+Misere_Board* Misere_UI::choose_board() {
+    int size = 3, length = 3;
+    cout << "Board size (" << Misere_Board::MIN_SIZE << "-" << Misere_Board::MAX_SIZE << ", 3 for the classic game): ";
+    if (!(cin >> size)) {
+        cin.clear();
+        cin.ignore(10000, '\n');
+        return new Misere_Board();
+    }
+    size = min(max(size, Misere_Board::MIN_SIZE), Misere_Board::MAX_SIZE);
+    if (size > Misere_Board::MIN_SIZE) {
+        cout << "Marks in a row that lose (" << Misere_Board::MIN_SIZE << "-" << size << "): ";
+        if (!(cin >> length)) {
+            cin.clear();
+            cin.ignore(10000, '\n');
+            length = 3;
+        }
+    }
+    return new Misere_Board(size, length);
+}
+
 Player<char>** Misere_UI::setup_players() {
     Player<char>** players = new Player<char>*[2];
     vector<string> type_options = { "Human", "Computer" };
@@ -294,10 +460,10 @@ Move<char>* Misere_UI::get_move(Player<char>* player) {
             cout << "Invalid.\n";
             cin.clear(); cin.ignore(10000, '\n');
         }
-        return new Move<char>(r, c, sym);
+        return move_slot.emplace(r, c, sym);
     } else {
         Misere_AIPlayer* ai = dynamic_cast<Misere_AIPlayer*>(player);
         char opp_sym = (sym == 'X') ? 'O' : 'X';
-        return ai->get_smart_move(board_ptr, opp_sym);
+        return move_slot.store(ai->get_smart_move(board_ptr, opp_sym));
     }
 }
\ No newline at end of file
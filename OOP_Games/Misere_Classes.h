@@ -3,27 +3,51 @@
  * @brief Header for Misere Tic-Tac-Toe.
  *
  * In Misère games, the winning condition is inverted: The player who
- * completes a line of 3 **loses**.
+ * completes a line **loses**. The classic game is 3 in a row on 3x3; the
+ * board also plays K in a row on N x N.
  */
 
 #ifndef MISERE_CLASSES_H
 #define MISERE_CLASSES_H
 
 #include "BoardGame_Classes.h"
+#include "Search_Classes.h"
+#include <cstdint>
 #include <string>
 #include <vector>
 
 using namespace std;
 
+struct Misere_Geometry;
+
 /**
  * @class Misere_Board
- * @brief Tic-Tac-Toe board where 3-in-a-row loses the game.
+ * @brief N x N Tic-Tac-Toe board where K in a row loses the game.
+ *
+ * Besides the cells, each side's marks are kept as a bitmask (bit r * N + c)
+ * and tested against a table of every K-cell line, built once per board
+ * shape, so a line check is a few mask compares whatever N and K are. The
+ * board also keeps its hash under each of its 8 rotations and reflections,
+ * so that a search can treat symmetric positions as one.
  */
 class Misere_Board : public Board<char> {
 public:
-    Misere_Board();
+    static constexpr int MIN_SIZE = 3; ///< Smallest board (and line) supported.
+    static constexpr int MAX_SIZE = 8; ///< Largest board; its cells fill a 64-bit mask.
+
+    /**
+     * @param size Cells per side, MIN_SIZE to MAX_SIZE (clamped).
+     * @param line_length Length of a losing line, MIN_SIZE to size (clamped).
+     */
+    explicit Misere_Board(int size = 3, int line_length = 3);
     virtual ~Misere_Board() {}
 
+    /** @brief Cells per side. */
+    int get_size() const { return rows; }
+
+    /** @brief Marks in a row that lose. */
+    int get_line_length() const { return line_length; }
+
     /**
      * @brief Updates board with move.
      * @param move Pointer to move.
@@ -39,16 +63,16 @@ public:
     virtual bool is_win(Player<char>* player) override;
 
     /**
-     * @brief Checks if player has lost (i.e., successfully made 3-in-a-row).
+     * @brief Checks if player has lost (i.e., made K in a row).
      * @param player Pointer to player.
-     * @return true if player has 3 consecutive symbols.
+     * @return true if player has a line of K symbols.
      */
     virtual bool is_lose(Player<char>* player) override;
 
     /**
      * @brief Checks for draw.
      * @param player Pointer to player.
-     * @return true if full and no 3-in-a-row (rare/impossible in 3x3 if filled? check logic).
+     * @return true if the board is full and nobody has K in a row.
      */
     virtual bool is_draw(Player<char>* player) override;
 
@@ -59,25 +83,108 @@ public:
      */
     virtual bool game_is_over(Player<char>* player) override;
 
-    bool player_has_three(char symbol) const;
+    /**
+     * @brief Lose if the last move completes a line of K, draw when full.
+     */
+    Outcome evaluate_last_move(Player<char>* player) override;
+
+    /**
+     * @brief Every empty cell.
+     */
+    int generate_moves(char symbol, MoveList<char>& moves) const override;
+
+    /**
+     * @brief Every empty cell, the ones that do not complete a line for
+     * `symbol` first, each group centre first in the canonical orientation
+     * (see get_canonical_hash()). Symmetric positions thus list the same
+     * moves, up to the symmetry, at the same indices.
+     */
+    int generate_canonical_moves(char symbol, MoveList<char>& moves) const;
+
+    /**
+     * @brief Smallest of the board's hashes under its 8 rotations and
+     * reflections; equal for symmetric positions.
+     */
+    uint64_t get_canonical_hash() const;
+
+    /**
+     * @brief Heuristic for `symbol` to move: cells it cannot take without
+     * completing a line are bad for it, those of the opponent good, and
+     * crowded open lines count a little against their owner.
+     */
+    int evaluate(char symbol) const;
+
+    bool player_has_line(char symbol) const;
     bool cell_empty(int r, int c) const;
-    vector<pair<int,int>> get_empty_cells() const;
 
     bool make_temp_move(int r, int c, char symbol);
     void undo_temp_move(int r, int c);
 
     /**
-     * @brief Checks if placing 'symbol' at (r,c) would create a 3-in-a-row line.
+     * @brief Checks if placing 'symbol' at (r,c) would create a K-in-a-row line.
      * Used by AI to avoid suicidal moves.
      */
-    bool placement_creates_three(int r, int c, char symbol) const;
+    bool placement_creates_line(int r, int c, char symbol) const;
 
     static const char blank_symbol;
+
+private:
+    int line_length;                  ///< K
+    const Misere_Geometry* geometry;  ///< Lines and symmetries of this N and K
+    uint64_t marks[2] = {};           ///< Cells of X and of O
+    uint64_t symmetric_hash[8] = {};  ///< Hash of the board under each rotation/reflection
+
+    /** @brief Writes a cell through set_cell(), keeping marks and symmetric_hash. */
+    void place(int r, int c, char symbol);
+
+    /** @brief Cells (r * N + c) where `symbol` would complete a line. */
+    uint64_t losing_cells(char symbol) const;
+
+    int canonical_symmetry() const;
+};
+
+/**
+ * @class Misere_Position
+ * @brief Search view of a Misere_Board for AlphaBetaSearch.
+ *
+ * Completing a line loses for the mover. Positions are keyed by the board's
+ * canonical hash and moves listed in canonical order, so the table holds
+ * one entry for all 8 symmetric images of a position.
+ */
+class Misere_Position {
+public:
+    typedef char Symbol;
+
+    /**
+     * @brief Starts a search on `board` with `symbol` to move.
+     */
+    Misere_Position(Misere_Board* board, char symbol);
+
+    int generate_moves(MoveList<char>& moves) const { return board->generate_canonical_moves(side, moves); }
+    void make_move(const Move<char>& move);
+    void undo_move(const Move<char>& move);
+    Outcome last_move_outcome() const;
+    int evaluate() const { return board->evaluate(side); }
+    uint64_t key() const;
+
+private:
+    Misere_Board* board;
+    char side;       ///< Side to move.
+    bool completed_line = false; ///< Whether the last move made K in a row.
 };
 
 /**
  * @class Misere_AIPlayer
- * @brief Smart AI for Misere Tic-Tac-Toe.
+ * @brief AI for Misere Tic-Tac-Toe.
+ *
+ * Every 3x3 position is solved at compile time, by a constexpr negamax
+ * over the 3^9 encodings, into a table built into the program; a move is
+ * one lookup. Among equal moves it prefers the centre, then corners, then
+ * edges, and it delays a loss (or hurries a win) as long as it can.
+ *
+ * Larger boards are searched (Misere_Position) within the search limits,
+ * by default half a second per move. The transposition table is kept from
+ * one move to the next, so the end of a game is usually solved exactly.
  */
 class Misere_AIPlayer : public Player<char> {
 public:
@@ -88,18 +195,29 @@ public:
      * @brief Calculates smart move to avoid winning (losing).
      * @param board Pointer to board.
      * @param opponent_symbol Opponent's char.
-     * @return Pointer to best Move.
+     * @return Best Move.
      */
-    Move<char>* get_smart_move(Misere_Board* board, char opponent_symbol);
+    Move<char> get_smart_move(Misere_Board* board, char opponent_symbol);
 
-private:
     /**
-     * @brief Recursive Minimax algorithm for Misere logic.
-     * @return +1 if AI wins (forces opponent to lose), -1 if AI loses.
+     * @brief Same lookup as get_smart_move() without any console output.
+     * @param board Pointer to board.
+     * @param opponent_symbol Opponent's char.
+     * @param score_out Optional, receives +1 if the opponent will be forced to
+     * complete a line, -1 if we will, 0 for a draw (or not known yet).
+     * @return Best Move.
      */
-    int backtrack_minimax(Misere_Board* board, char current_symbol);
+    Move<char> choose_move(Misere_Board* board, char opponent_symbol, int* score_out = nullptr);
 
-    pair<int,int> tiebreak_choose(const vector<pair<int,int>>& choices);
+    /** @brief Budget of each search on boards other than 3x3. */
+    void set_search_limits(const SearchLimits& new_limits) { limits = new_limits; }
+
+    /** @brief Positions visited by all searches of this player so far (none on 3x3). */
+    long long get_search_nodes() const { return search.nodes_searched(); }
+
+private:
+    SearchLimits limits;                       ///< Budget of each search.
+    AlphaBetaSearch<Misere_Position> search{20}; ///< Engine for boards other than 3x3.
 };
 
 /**
@@ -112,6 +230,12 @@ public:
     Misere_UI(Misere_Board* board);
     virtual ~Misere_UI() {}
 
+    /**
+     * @brief Asks for the board size and losing line length.
+     * @return A new board (3 in a row on 3x3 if the answers are not numbers).
+     */
+    static Misere_Board* choose_board();
+
     virtual Player<char>** setup_players() override;
     virtual Player<char>* create_player(string& name, char symbol, PlayerType type) override;
     virtual Move<char>* get_move(Player<char>* player) override;
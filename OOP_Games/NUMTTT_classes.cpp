@@ -20,11 +20,7 @@ using namespace std;
 
 NumTTT_Board::NumTTT_Board() : Board(3, 3) {
     // Initialize board with 0 (blank)
-    for (auto &row : board) {
-        for (auto &cell : row) {
-            cell = blank_symbol;
-        }
-    }
+    fill_cells(blank_symbol);
     // Initialize number pools
     odd_nums = {1, 3, 5, 7, 9};
     even_nums = {2, 4, 6, 8};
@@ -42,7 +38,7 @@ bool NumTTT_Board::update_board(Move<int>* move) {
     }
 
     // 2. Check Empty
-    if (board[x][y] != blank_symbol) {
+    if (cell(x, y) != blank_symbol) {
        cout << "Invalid move: Cell occupied.\n";
         return false;
     }
@@ -69,8 +65,9 @@ bool NumTTT_Board::update_board(Move<int>* move) {
     }
 
     // 4. Apply
-    board[x][y] = number;
+    set_cell(x, y, number);
     n_moves++;
+    record_move(x, y);
     return true;
 }
 
@@ -78,25 +75,25 @@ bool NumTTT_Board::check_all_lines() {
     int sum;
     // Rows
     for (int i = 0; i < 3; ++i) {
-        if (board[i][0] && board[i][1] && board[i][2]) {
-            sum = board[i][0] + board[i][1] + board[i][2];
+        if (cell(i, 0) && cell(i, 1) && cell(i, 2)) {
+            sum = cell(i, 0) + cell(i, 1) + cell(i, 2);
             if (sum == 15) return true;
         }
     }
     // Columns
     for (int j = 0; j < 3; ++j) {
-        if (board[0][j] && board[1][j] && board[2][j]) {
-            sum = board[0][j] + board[1][j] + board[2][j];
+        if (cell(0, j) && cell(1, j) && cell(2, j)) {
+            sum = cell(0, j) + cell(1, j) + cell(2, j);
             if (sum == 15) return true;
         }
     }
     // Diagonals
-    if (board[0][0] && board[1][1] && board[2][2]) {
-        sum = board[0][0] + board[1][1] + board[2][2];
+    if (cell(0, 0) && cell(1, 1) && cell(2, 2)) {
+        sum = cell(0, 0) + cell(1, 1) + cell(2, 2);
         if (sum == 15) return true;
     }
-    if (board[0][2] && board[1][1] && board[2][0]) {
-        sum = board[0][2] + board[1][1] + board[2][0];
+    if (cell(0, 2) && cell(1, 1) && cell(2, 0)) {
+        sum = cell(0, 2) + cell(1, 1) + cell(2, 0);
         if (sum == 15) return true;
     }
 
@@ -115,6 +112,31 @@ bool NumTTT_Board::game_is_over(Player<int>* player) {
     return is_win(player) || is_draw(player);
 }
 
+int NumTTT_Board::generate_moves(int symbol, MoveList<int>& moves) const {
+    const vector<int>& numbers = (symbol == 1) ? odd_nums : even_nums;
+    moves.clear();
+    for (int r = 0; r < rows; ++r)
+        for (int c = 0; c < columns; ++c)
+            if (cell(r, c) == blank_symbol)
+                for (int number : numbers) moves.add(r, c, number);
+    return moves.size();
+}
+
+Outcome NumTTT_Board::evaluate_last_move(Player<int>* player) {
+    // Sum of a full line starting at (r, c) in direction (dr, dc)
+    auto makes_15 = [&](int r, int c, int dr, int dc) {
+        int a = cell(r, c), b = cell(r + dr, c + dc), d = cell(r + 2 * dr, c + 2 * dc);
+        return a && b && d && a + b + d == 15;
+    };
+
+    int r = last_x, c = last_y;
+    if (makes_15(r, 0, 0, 1) || makes_15(0, c, 1, 0) ||
+        (r == c && makes_15(0, 0, 1, 1)) || (r + c == 2 && makes_15(0, 2, 1, -1)))
+        return Outcome::WIN;
+    if (n_moves == 9) return Outcome::DRAW;
+    return Outcome::ONGOING;
+}
+
 // -----------------------------------------------------------------------------
 // NumTTT_UI Implementation
 // -----------------------------------------------------------------------------
@@ -178,11 +200,11 @@ Move<int> *NumTTT_UI::get_move(Player<int> *player) {
         do {
             x = rand() % r;
             y = rand() % c;
-        } while (board_ptr->get_board_matrix()[x][y] != 0);
+        } while (board_ptr->get_cell(x, y) != 0);
 
         cout << "Computer chose number " << number << " at (" << x << ", " << y << ")\n";
     }
-    return new Move<int>(x, y, number);
+    return move_slot.emplace(x, y, number);
 }
 
 void NumTTT_UI::print_available(const vector<int> &nums) {
@@ -76,6 +76,16 @@ public:
      */
     bool game_is_over(Player<int>* player) override;
 
+    /**
+     * @brief Win if a line through the last cell sums to 15, draw after 9 moves.
+     */
+    Outcome evaluate_last_move(Player<int>* player) override;
+
+    /**
+     * @brief Every empty cell with every number left to the player (`symbol` 1 = odd, 2 = even).
+     */
+    int generate_moves(int symbol, MoveList<int>& moves) const override;
+
     const vector<int>& get_odd_nums() const { return odd_nums; }
     const vector<int>& get_even_nums() const { return even_nums; }
 };
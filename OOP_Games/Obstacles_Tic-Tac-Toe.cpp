@@ -8,24 +8,12 @@
 #include <iomanip>
 #include <cctype>
 
-obstacles_TTT_board::obstacles_TTT_board() : Board(6, 6) {
-     for (auto& row : board) {
-          for (auto& cell : row) {
-               cell = blank_symbol;
-          }
-     }
+obstacles_TTT_board::obstacles_TTT_board(unsigned seed) : Board(6, 6), rng(seed) {
+     fill_cells(blank_symbol);
 }
 
-vector<pair<int, int>> obstacles_TTT_board::get_moves() {
-     vector<pair<int, int>> moves;
-     for (int i = 0; i < rows; i++) {
-          for (int j = 0; j < columns; j++) {
-               if (board[i][j] == blank_symbol) {
-                    moves.push_back(make_pair(i, j));
-               }
-          }
-     }
-     return moves;
+int obstacles_TTT_board::generate_moves(char symbol, MoveList<char> &moves) const {
+     return generate_placements(blank_symbol, symbol, moves);
 }
 
 bool obstacles_TTT_board::update_board(Move<char> *move) {
@@ -34,22 +22,25 @@ bool obstacles_TTT_board::update_board(Move<char> *move) {
      char symbol = move->get_symbol();
 
      // Validate bounds and emptiness
-     if ( x < 0 || x >= rows || y < 0 || y >= columns || board[x][y] != '.' ) {
+     if ( x < 0 || x >= rows || y < 0 || y >= columns || cell(x, y) != '.' ) {
           return false;
      }
 
-     board[x][y] = symbol;
+     set_cell(x, y, symbol);
      n_moves++;
+     record_move(x, y);
 
      // Place obstacles randomly every 2 moves
      if (n_moves % 2 == 0) {
+         MoveList<char> moves;
          for (int i = 0; i < 2; i++) {
-              auto moves = get_moves();
+              generate_moves(obstacle_symbol, moves);
               if (!moves.empty()) {
-                   int r = rand() % moves.size();
-                   int k = moves[r].first;
-                   int l = moves[r].second;
-                   board[k][l] = obstacle_symbol;
+                   int r = (int)(rng() % moves.size());
+                   int k = moves[r].get_x();
+                   int l = moves[r].get_y();
+                   set_cell(k, l, obstacle_symbol);
+                   n_obstacles++;
               }
          }
      }
@@ -64,20 +55,19 @@ bool obstacles_TTT_board::check_win() {
      // Check rows (scan for 4 in a row)
      for (int i = 0; i < rows; i++) {
           for (int j = 0; j < columns; j++) {
-               if (i + 3 >= rows) break;
                // 1. Horizontal
-               if (j + 3 < columns && all_equal(board[i][j], board[i][j+1], board[i][j+2], board[i][j+3])) return true;
+               if (j + 3 < columns && all_equal(cell(i, j), cell(i, j+1), cell(i, j+2), cell(i, j+3))) return true;
 
                // 2. Vertical
-               if (i + 3 < rows && all_equal(board[i][j], board[i+1][j], board[i+2][j], board[i+3][j])) return true;
+               if (i + 3 < rows && all_equal(cell(i, j), cell(i+1, j), cell(i+2, j), cell(i+3, j))) return true;
 
                // 3. Diagonal (Down-Right)
                if (i + 3 < rows && j + 3 < columns &&
-                   all_equal(board[i][j], board[i+1][j+1], board[i+2][j+2], board[i+3][j+3])) return true;
+                   all_equal(cell(i, j), cell(i+1, j+1), cell(i+2, j+2), cell(i+3, j+3))) return true;
 
                // 4. Anti-Diagonal (Down-Left)
                if (i + 3 < rows && j - 3 >= 0 &&
-                   all_equal(board[i][j], board[i+1][j-1], board[i+2][j-2], board[i+3][j-3])) return true;
+                   all_equal(cell(i, j), cell(i+1, j-1), cell(i+2, j-2), cell(i+3, j-3))) return true;
           }
      }
      return false;
@@ -89,13 +79,21 @@ bool obstacles_TTT_board::is_win(Player<char> *) {
 
 bool obstacles_TTT_board::is_draw(Player<char> *) {
      // Draw if no moves left
-     return get_moves().empty();
+     return n_moves + n_obstacles == rows * columns;
 }
 
 bool obstacles_TTT_board::is_lose(Player<char> *) { return false; }
 
 bool obstacles_TTT_board::game_is_over(Player<char> *) {
-     return check_win() || get_moves().empty();
+     return check_win() || n_moves + n_obstacles == rows * columns;
+}
+
+Outcome obstacles_TTT_board::evaluate_last_move(Player<char> *player) {
+     // Obstacles only fill empty cells, so a new line must run through the last move
+     if (cell(last_x, last_y) == player->get_symbol() && has_line_through(last_x, last_y, 4))
+          return Outcome::WIN;
+     if (n_moves + n_obstacles == rows * columns) return Outcome::DRAW;
+     return Outcome::ONGOING;
 }
 
 // --- UI ---
@@ -113,11 +111,10 @@ Move<char> *obstacles_TTT_UI::get_move(Player<char> *player) {
      if (player->get_type() == PlayerType::HUMAN) {
           cout << "Enter row: "; cin >> x;
           cout << "Enter column: "; cin >> y;
-          return new Move<char>(x, y, player->get_symbol());
+          return move_slot.emplace(x, y, player->get_symbol());
      } else {
-          auto move = board->get_moves();
-          if (move.empty()) return nullptr;
-          auto rand_move = rand() % move.size();
-          return new Move<char>(move[rand_move].first, move[rand_move].second, player->get_symbol());
+          MoveList<char> moves;
+          if (board->generate_moves(player->get_symbol(), moves) == 0) return nullptr;
+          return move_slot.store(moves[rand() % moves.size()]);
      }
 }
\ No newline at end of file
@@ -11,6 +11,7 @@
 
 #include "BoardGame_Classes.h"
 #include<iostream>
+#include <random>
 using namespace std;
 
 /**
@@ -19,17 +20,29 @@ using namespace std;
  *
  * Inherits from Board<char>. Includes logic for placing obstacles
  * and checking for a 4-in-a-row win condition on a 6x6 grid.
+ *
+ * Obstacles are drawn from the board's own generator rather than rand(),
+ * so a board seeded with set_seed() drops the same obstacles for the same
+ * moves, whatever else in the process uses rand().
  */
 class obstacles_TTT_board : public Board<char> {
 private:
     char blank_symbol = '.';      ///< Represents an empty cell.
     char obstacle_symbol = '#';   ///< Represents a blocked cell (obstacle).
+    int n_obstacles = 0;          ///< Obstacles placed so far.
+    minstd_rand rng;              ///< Picks the obstacle cells.
 
 public:
     /**
      * @brief Default constructor for Obstacles Tic-Tac-Toe board.
+     * @param seed Seed of the obstacle placement; a fresh random one by default.
+     */
+    explicit obstacles_TTT_board(unsigned seed = random_device{}());
+
+    /**
+     * @brief Restarts the obstacle placement from `seed`.
      */
-    obstacles_TTT_board();
+    void set_seed(unsigned seed) { rng.seed(seed); }
 
     /**
      * @brief Updates the board with the player's move and potentially adds obstacles.
@@ -68,16 +81,20 @@ public:
     bool game_is_over(Player<char> *) override;
 
     /**
-     * @brief Helper function to check for 4 consecutive symbols.
-     * @return true if any line of 4 exists.
+     * @brief Win if four connect through the last move, draw when no cell is free.
      */
-    bool check_win();
+    Outcome evaluate_last_move(Player<char>* player) override;
 
     /**
-     * @brief Returns list of all empty cells.
-     * @return Vector of coordinate pairs (row, col).
+     * @brief Every cell that is neither taken nor blocked.
      */
-    vector<pair<int, int>> get_moves();
+    int generate_moves(char symbol, MoveList<char>& moves) const override;
+
+    /**
+     * @brief Helper function to check for 4 consecutive symbols.
+     * @return true if any line of 4 exists.
+     */
+    bool check_win();
 };
 
 /**
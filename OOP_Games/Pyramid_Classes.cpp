@@ -36,9 +36,9 @@ Pyramid_Board::Pyramid_Board() : Board(3, 5) {
     for (int row = 0; row < rows; ++row) {
         for (int col = 0; col < columns; ++col) {
             if (is_valid_position(row, col)) {
-                board[row][col] = '.';
+                set_cell(row, col, '.');
             } else {
-                board[row][col] = ' ';
+                set_cell(row, col, ' ');
             }
         }
     }
@@ -51,10 +51,11 @@ bool Pyramid_Board::update_board(Move<char> *move) {
 
     if (row < 0 || row >= rows || col < 0 || col >= columns) return false;
     if (!is_valid_position(row, col)) return false;
-    if (board[row][col] != '.') return false;
+    if (cell(row, col) != '.') return false;
 
-    board[row][col] = token;
+    set_cell(row, col, token);
     n_moves++;
+    record_move(row, col);
     return true;
 }
 
@@ -69,17 +70,17 @@ bool Pyramid_Board::is_win(Player<char> *player) {
  */
 bool Pyramid_Board::check_win_symbol(char s) {
     // Horizontal lines
-    if (board[1][1] == s && board[1][2] == s && board[1][3] == s) return true;
-    if (board[2][0] == s && board[2][1] == s && board[2][2] == s) return true;
-    if (board[2][1] == s && board[2][2] == s && board[2][3] == s) return true;
-    if (board[2][2] == s && board[2][3] == s && board[2][4] == s) return true;
+    if (cell(1, 1) == s && cell(1, 2) == s && cell(1, 3) == s) return true;
+    if (cell(2, 0) == s && cell(2, 1) == s && cell(2, 2) == s) return true;
+    if (cell(2, 1) == s && cell(2, 2) == s && cell(2, 3) == s) return true;
+    if (cell(2, 2) == s && cell(2, 3) == s && cell(2, 4) == s) return true;
 
     // Vertical line (center column)
-    if (board[0][2] == s && board[1][2] == s && board[2][2] == s) return true;
+    if (cell(0, 2) == s && cell(1, 2) == s && cell(2, 2) == s) return true;
 
     // Diagonals
-    if (board[0][2] == s && board[1][1] == s && board[2][0] == s) return true; // /
-    if (board[0][2] == s && board[1][3] == s && board[2][4] == s) return true; // \
+    if (cell(0, 2) == s && cell(1, 1) == s && cell(2, 0) == s) return true; // /
+    if (cell(0, 2) == s && cell(1, 3) == s && cell(2, 4) == s) return true; // \
 
     return false;
 }
@@ -95,68 +96,58 @@ bool Pyramid_Board::game_is_over(Player<char> *player) {
     return is_win(player) || is_draw(player);
 }
 
-vector<pair<int, int> > Pyramid_Board::get_valid_moves() {
-    vector<pair<int, int> > moves;
-    for (int row = 0; row < rows; ++row) {
-        for (int col = 0; col < columns; ++col) {
-            if (is_valid_position(row, col) && board[row][col] == '.') {
-                moves.push_back({row, col});
-            }
-        }
-    }
-    return moves;
+Outcome Pyramid_Board::evaluate_last_move(Player<char> *player) {
+    // Cells outside the pyramid hold ' ', so runs never cross its edge
+    if (cell(last_x, last_y) == player->get_symbol() && has_line_through(last_x, last_y, 3))
+        return Outcome::WIN;
+    if (n_moves == 9) return Outcome::DRAW;
+    return Outcome::ONGOING;
 }
 
-/**
- * @brief Minimax algorithm implementation.
- * Calculates score: Positive for AI win, Negative for Human win.
- */
-int Pyramid_Board::minimax(int depth, bool isMaximizing, char aiSymbol, char humanSymbol) {
-    if (check_win_symbol(aiSymbol)) return 10 - depth;
-    if (check_win_symbol(humanSymbol)) return depth - 10;
-
-    vector<pair<int, int> > validMoves = get_valid_moves();
-    if (validMoves.empty()) return 0; // Draw
-
-    if (isMaximizing) {
-        int bestScore = -1000;
-        for (auto &move: validMoves) {
-            board[move.first][move.second] = aiSymbol;
-            int score = minimax(depth + 1, false, aiSymbol, humanSymbol);
-            board[move.first][move.second] = '.'; // Backtrack
-            bestScore = max(bestScore, score);
-        }
-        return bestScore;
-    } else {
-        int bestScore = 1000;
-        for (auto &move: validMoves) {
-            board[move.first][move.second] = humanSymbol;
-            int score = minimax(depth + 1, true, aiSymbol, humanSymbol);
-            board[move.first][move.second] = '.'; // Backtrack
-            bestScore = min(bestScore, score);
-        }
-        return bestScore;
-    }
+int Pyramid_Board::generate_moves(char symbol, MoveList<char> &moves) const {
+    // Cells outside the pyramid hold ' ', so only real cells can be '.'
+    return generate_placements('.', symbol, moves);
 }
 
 pair<int, int> Pyramid_Board::get_best_move(char aiSymbol) {
-    char humanSymbol = (aiSymbol == 'X') ? 'O' : 'X';
-    vector<pair<int, int> > validMoves = get_valid_moves();
+    Pyramid_Position pos(this, aiSymbol);
+    SearchResult<char> result = search.search(pos, 9);
+    if (!result.found) return {-1, -1};
+    return {result.best.get_x(), result.best.get_y()};
+}
 
-    int bestScore = -1000;
-    pair<int, int> bestMove = {-1, -1};
+// --------------------------------------------------------------------
+// Pyramid_Position Implementation
+// --------------------------------------------------------------------
 
-    for (auto &move: validMoves) {
-        board[move.first][move.second] = aiSymbol;
-        int score = minimax(0, false, aiSymbol, humanSymbol);
-        board[move.first][move.second] = '.';
+Pyramid_Position::Pyramid_Position(Pyramid_Board *board, char symbol) : board(board), side(symbol) {}
 
-        if (score > bestScore) {
-            bestScore = score;
-            bestMove = move;
-        }
-    }
-    return bestMove;
+int Pyramid_Position::generate_moves(MoveList<char> &moves) const {
+    return board->generate_moves(side, moves);
+}
+
+void Pyramid_Position::make_move(const Move<char> &move) {
+    board->set_cell(move.get_x(), move.get_y(), side);
+    board->n_moves++;
+    last_x = move.get_x();
+    last_y = move.get_y();
+    side = (side == 'X') ? 'O' : 'X';
+}
+
+void Pyramid_Position::undo_move(const Move<char> &move) {
+    board->set_cell(move.get_x(), move.get_y(), '.');
+    board->n_moves--;
+    side = (side == 'X') ? 'O' : 'X';
+}
+
+Outcome Pyramid_Position::last_move_outcome() const {
+    if (board->has_line_through(last_x, last_y, 3)) return Outcome::WIN;
+    if (board->n_moves == 9) return Outcome::DRAW;
+    return Outcome::ONGOING;
+}
+
+uint64_t Pyramid_Position::key() const {
+    return board->get_hash() ^ search_side_key(side);
 }
 
 // -----------------------------------------------------------------------------
@@ -175,7 +166,7 @@ Move<char> *Pyramid_UI::get_move(Player<char> *player) {
         while (true) {
             cout << player->get_name() << " (" << player->get_symbol() << "), enter your move (row col): ";
             if (cin >> x >> y) {
-                if (board_ptr->is_valid_position(x, y) && board_ptr->get_board_matrix()[x][y] == '.') {
+                if (board_ptr->is_valid_position(x, y) && board_ptr->get_cell(x, y) == '.') {
                     break;
                 } else {
                     cout << "Invalid move. Please try again.\n";
@@ -186,11 +177,11 @@ Move<char> *Pyramid_UI::get_move(Player<char> *player) {
                 cin.ignore(10000, '\n');
             }
         }
-        return new Move<char>(x, y, player->get_symbol());
+        return move_slot.emplace(x, y, player->get_symbol());
     } else {
         cout << "AI is thinking...\n";
         pair<int, int> best_move = board_ptr->get_best_move(player->get_symbol());
         cout << "Player " << player->get_name() << " chooses " << best_move.first << " " << best_move.second << endl;
-        return new Move<char>(best_move.first, best_move.second, player->get_symbol());
+        return move_slot.emplace(best_move.first, best_move.second, player->get_symbol());
     }
 }
\ No newline at end of file
@@ -10,6 +10,7 @@
 #define PYRAMID_CLASSES_H
 
 #include "BoardGame_Classes.h"
+#include "Search_Classes.h"
 #include <vector>
 #include <string>
 #include <algorithm>
@@ -17,6 +18,37 @@
 
 using namespace std;
 
+class Pyramid_Board;
+
+/**
+ * @class Pyramid_Position
+ * @brief Search view of a Pyramid_Board for AlphaBetaSearch.
+ *
+ * Nine cells are few enough to search to the end, so there is no heuristic.
+ */
+class Pyramid_Position {
+public:
+    typedef char Symbol;
+
+    /**
+     * @brief Starts a search on `board` with `symbol` to move.
+     */
+    Pyramid_Position(Pyramid_Board* board, char symbol);
+
+    int generate_moves(MoveList<char>& moves) const;
+    void make_move(const Move<char>& move);
+    void undo_move(const Move<char>& move);
+    Outcome last_move_outcome() const;
+    int evaluate() const { return 0; }
+    uint64_t key() const;
+
+private:
+    Pyramid_Board* board;
+    char side;       ///< Side to move.
+    int last_x = -1; ///< Row of the last mark.
+    int last_y = -1; ///< Column of the last mark.
+};
+
 /**
  * @class Pyramid_Board
  * @brief Represents the pyramid-shaped board.
@@ -28,6 +60,10 @@ using namespace std;
  * - Row 2: Cols 0, 1, 2, 3, 4
  */
 class Pyramid_Board : public Board<char> {
+    friend class Pyramid_Position;
+
+    AlphaBetaSearch<Pyramid_Position> search{14}; ///< Engine behind get_best_move().
+
 public:
     /**
      * @brief Constructor. Initializes the pyramid shape.
@@ -69,6 +105,16 @@ public:
      */
     bool game_is_over(Player<char>* player) override;
 
+    /**
+     * @brief Win if a line runs through the last move, draw after 9 moves.
+     */
+    Outcome evaluate_last_move(Player<char>* player) override;
+
+    /**
+     * @brief Every empty cell of the pyramid.
+     */
+    int generate_moves(char symbol, MoveList<char>& moves) const override;
+
     /**
      * @brief Checks if a matrix coordinate corresponds to a valid pyramid cell.
      * @param row Matrix row index (0-2).
@@ -77,12 +123,6 @@ public:
      */
     bool is_valid_position(int row, int col);
 
-    /**
-     * @brief Returns a list of all valid empty cells (used by AI).
-     * @return Vector of valid coordinates.
-     */
-    vector<pair<int, int>> get_valid_moves();
-
 
     /**
      * @brief Checks if a specific symbol has won.
@@ -93,21 +133,14 @@ public:
     bool check_win_symbol(char symbol);
 
     /**
-     * @brief Computes the best move for the AI using Minimax.
+     * @brief Computes the best move for the AI with a full alpha-beta search.
      * @param aiSymbol The AI's symbol.
-     * @return The best (row, col) pair.
+     * @return The best (row, col) pair, or (-1, -1) if the pyramid is full.
      */
     pair<int, int> get_best_move(char aiSymbol);
 
-    /**
-     * @brief The Minimax recursive algorithm.
-     * @param depth Current depth of the recursion.
-     * @param isMaximizing true if it's the AI's turn to maximize score.
-     * @param aiSymbol AI's symbol.
-     * @param humanSymbol Opponent's symbol.
-     * @return The score of the board state.
-     */
-    int minimax(int depth, bool isMaximizing, char aiSymbol, char humanSymbol);
+    /** @brief Positions visited by all searches of this board so far. */
+    long long get_search_nodes() const { return search.nodes_searched(); }
 };
 
 /**
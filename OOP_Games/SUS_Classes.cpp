@@ -11,11 +11,7 @@
 using namespace std;
 
 SUS_Board::SUS_Board() : Board(3, 3) {
-    for (auto& row : board) {
-        for (auto& cell : row) {
-            cell = blank_symbol;
-        }
-    }
+    fill_cells(blank_symbol);
 }
 
 void SUS_Board::set_player_letters(char p1_letter, char p2_letter) {
@@ -58,9 +54,9 @@ int SUS_Board::check_and_score_sequences(int last_x, int last_y, char symbol) {
                                  (x3 == last_x && y3 == last_y);
 
         if (contains_last_move) {
-            char a = board[x1][y1];
-            char b = board[x2][y2];
-            char c = board[x3][y3];
+            char a = cell(x1, y1);
+            char b = cell(x2, y2);
+            char c = cell(x3, y3);
 
             if (a != blank_symbol && b != blank_symbol && c != blank_symbol) {
                 if (a == 'S' && b == 'U' && c == 'S') {
@@ -78,10 +74,11 @@ bool SUS_Board::update_board(Move<char>* move) {
     char symbol = move->get_symbol();
 
     if (x < 0 || x >= rows || y < 0 || y >= columns) return false;
-    if (board[x][y] != blank_symbol) return false;
+    if (cell(x, y) != blank_symbol) return false;
 
-    board[x][y] = symbol;
+    set_cell(x, y, symbol);
     n_moves++;
+    record_move(x, y);
 
     // Calculate score immediately
     int points = check_and_score_sequences(x, y, symbol);
@@ -122,20 +119,26 @@ bool SUS_Board::game_is_over(Player<char>* player) {
     return n_moves == 9; // Game ends when board is full
 }
 
-vector<pair<int, int>> SUS_Board::get_valid_moves() {
-    vector<pair<int, int>> valid_moves;
-    for (int i = 0; i < rows; i++) {
-        for (int j = 0; j < columns; j++) {
-            if (board[i][j] == blank_symbol) valid_moves.push_back({i, j});
-        }
-    }
-    return valid_moves;
+Outcome SUS_Board::evaluate_last_move(Player<char>* player) {
+    // Scores are kept up to date by update_board; only the final move decides
+    if (n_moves < 9) return Outcome::ONGOING;
+
+    bool is_player1 = (player->get_symbol() == player1_letter);
+    int mine = is_player1 ? player1_score : player2_score;
+    int theirs = is_player1 ? player2_score : player1_score;
+    if (mine > theirs) return Outcome::WIN;
+    if (mine < theirs) return Outcome::LOSE;
+    return Outcome::DRAW;
+}
+
+int SUS_Board::generate_moves(char symbol, MoveList<char>& moves) const {
+    return generate_placements(blank_symbol, symbol, moves);
 }
 
 // AI evaluation
 int SUS_Board::evaluate_move(int x, int y, char symbol, int depth) {
-    char original_value = board[x][y];
-    board[x][y] = symbol;
+    char original_value = cell(x, y);
+    set_cell(x, y, symbol);
 
     int immediate_ai_score = check_and_score_sequences(x, y, symbol);
 
@@ -144,15 +147,16 @@ int SUS_Board::evaluate_move(int x, int y, char symbol, int depth) {
     int opponent_scoring_risk = 0;
 
     if (depth > 0) {
-        auto valid_moves = get_valid_moves();
-        for (auto& move : valid_moves) {
-            int opp_x = move.first;
-            int opp_y = move.second;
-            char opp_original = board[opp_x][opp_y];
-            board[opp_x][opp_y] = opponent_symbol;
+        MoveList<char> valid_moves;
+        generate_moves(opponent_symbol, valid_moves);
+        for (const Move<char>& move : valid_moves) {
+            int opp_x = move.get_x();
+            int opp_y = move.get_y();
+            char opp_original = cell(opp_x, opp_y);
+            set_cell(opp_x, opp_y, opponent_symbol);
 
             int score = check_and_score_sequences(opp_x, opp_y, opponent_symbol);
-            board[opp_x][opp_y] = opp_original;
+            set_cell(opp_x, opp_y, opp_original);
 
             if (score > 0) {
                 opponent_scoring_risk = score;
@@ -161,13 +165,30 @@ int SUS_Board::evaluate_move(int x, int y, char symbol, int depth) {
         }
     }
 
-    board[x][y] = original_value;
+    set_cell(x, y, original_value);
 
     if (immediate_ai_score > 0) return 1000; // Priority: Score points
     else if (opponent_scoring_risk > 0) return 100; // Block opponent
     else return 500; // Neutral
 }
 
+pair<int, int> SUS_Board::get_best_move(char symbol) {
+    MoveList<char> valid_moves;
+    if (generate_moves(symbol, valid_moves) == 0) return {-1, -1};
+
+    int best_score = -1;
+    pair<int, int> best_move = {valid_moves[0].get_x(), valid_moves[0].get_y()};
+
+    for (const Move<char>& move : valid_moves) {
+        int score = evaluate_move(move.get_x(), move.get_y(), symbol, 2);
+        if (score > best_score) {
+            best_score = score;
+            best_move = {move.get_x(), move.get_y()};
+        }
+    }
+    return best_move;
+}
+
 // --- SUS_UI Implementation ---
 
 SUS_UI::SUS_UI(SUS_Board* board) :
@@ -233,29 +254,19 @@ Move<char>* SUS_UI::get_move(Player<char>* player) {
         while (true) {
             cout << "Enter position (row col, 0-2): ";
             if (cin >> x >> y) {
-                if (x >= 0 && x < 3 && y >= 0 && y < 3 && board_ptr->get_board_matrix()[x][y] == '.') break;
+                if (x >= 0 && x < 3 && y >= 0 && y < 3 && board_ptr->get_cell(x, y) == '.') break;
                 else cout << "Invalid or occupied position.\n";
             } else {
                 cout << "Invalid input.\n"; cin.clear(); cin.ignore(10000, '\n');
             }
         }
-        return new Move<char>(x, y, player->get_symbol());
+        return move_slot.emplace(x, y, player->get_symbol());
     } else {
         // AI Logic
-        auto valid_moves = board_ptr->get_valid_moves();
-        if (valid_moves.empty()) return new Move<char>(-1, -1, player->get_symbol());
-
-        int best_score = -1;
-        pair<int, int> best_move = valid_moves[0];
+        pair<int, int> best_move = board_ptr->get_best_move(player->get_symbol());
+        if (best_move.first == -1) return move_slot.emplace(-1, -1, player->get_symbol());
 
-        for (auto& move : valid_moves) {
-            int score = board_ptr->evaluate_move(move.first, move.second, player->get_symbol(), 2);
-            if (score > best_score) {
-                best_score = score;
-                best_move = move;
-            }
-        }
         cout << "Computer placed at (" << best_move.first << ", " << best_move.second << ")\n";
-        return new Move<char>(best_move.first, best_move.second, player->get_symbol());
+        return move_slot.emplace(best_move.first, best_move.second, player->get_symbol());
     }
 }
\ No newline at end of file
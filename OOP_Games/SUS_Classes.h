@@ -82,17 +82,22 @@ public:
      */
     bool game_is_over(Player<char>* player) override;
 
+    /**
+     * @brief Ongoing until the board is full, then compares the running scores.
+     */
+    Outcome evaluate_last_move(Player<char>* player) override;
+
+    /**
+     * @brief Every empty cell, for the given letter.
+     */
+    int generate_moves(char symbol, MoveList<char>& moves) const override;
+
     void set_player_letters(char p1_letter, char p2_letter);
     int get_player1_score() const { return player1_score; }
     int get_player2_score() const { return player2_score; }
     char get_player1_letter() const { return player1_letter; }
     char get_player2_letter() const { return player2_letter; }
 
-    /**
-     * @brief Returns list of valid moves.
-     * @return Vector of empty cell coordinates.
-     */
-    vector<pair<int, int>> get_valid_moves();
 
     /**
      * @brief Heuristic evaluation for AI to determine move quality.
@@ -103,6 +108,13 @@ public:
      * @return Score evaluation.
      */
     int evaluate_move(int x, int y, char symbol, int depth = 2);
+
+    /**
+     * @brief Picks the computer's move by scoring every empty cell with evaluate_move().
+     * @param symbol Letter the computer plays.
+     * @return Best (row, col), or (-1, -1) if the board is full.
+     */
+    pair<int, int> get_best_move(char symbol);
 };
 
 /**
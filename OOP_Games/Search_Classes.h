@@ -0,0 +1,515 @@
+/**
+ * @file Search_Classes.h
+ * @brief Generic negamax / alpha-beta search shared by the computer players.
+ *
+ * A game plugs in by writing a small position class around its board (see
+ * AlphaBetaSearch for what it must provide). The engine adds iterative
+ * deepening, a transposition table and move ordering (hash move, killer
+ * moves, history) on top, so every improvement here reaches all the games
+ * that use it.
+ */
+
+#ifndef SEARCH_CLASSES_H
+#define SEARCH_CLASSES_H
+
+#include "BoardGame_Classes.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+/** @brief Score of a win on the spot; a win k plies away scores SEARCH_WIN - k. */
+const int SEARCH_WIN = 1000000;
+
+/** @brief Larger than any score the search can return. */
+const int SEARCH_INF = 2 * SEARCH_WIN;
+
+/** @brief Deepest search the engine supports, in plies. */
+const int SEARCH_MAX_PLY = 64;
+
+/**
+ * @brief True if `score` is a forced win or loss rather than a heuristic value.
+ */
+inline bool search_is_decisive(int score) {
+    return score >= SEARCH_WIN - SEARCH_MAX_PLY || score <= -(SEARCH_WIN - SEARCH_MAX_PLY);
+}
+
+/**
+ * @brief Key of the side to move, to XOR into a board's Zobrist hash.
+ *
+ * Board<T>::get_hash() covers the cells only; positions return
+ * `board->get_hash() ^ search_side_key(side)`.
+ */
+template <typename T>
+uint64_t search_side_key(const T& side) {
+    uint64_t z = (uint64_t)hash<T>()(side) + 0x632BE59BD9B4E019ull;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+/**
+ * @brief How far a search may go.
+ *
+ * The depth limit is checked between iterations. The node and time budgets
+ * are checked inside them too, so a search can stop part-way through an
+ * iteration; the unfinished iteration is then thrown away. The first
+ * iteration always completes, so there is always a move to play.
+ */
+struct SearchLimits {
+    int max_depth = SEARCH_MAX_PLY; ///< Deepest iteration, in plies.
+    long long max_nodes = 0;        ///< Positions to visit at most; 0 for no limit.
+    double max_seconds = 0;         ///< Wall-clock budget; 0 for no limit.
+};
+
+/**
+ * @brief What a search found.
+ * @tparam T Type of symbol used in the moves.
+ */
+template <typename T>
+struct SearchResult {
+    Move<T> best;          ///< Best move found (meaningless if !found)
+    bool found = false;    ///< False if the side to move had no move
+    int score = 0;         ///< Score of `best` for the side to move
+    int depth = 0;         ///< Depth of the last completed iteration
+    long long nodes = 0;   ///< Positions visited
+    bool stopped = false;  ///< A budget ran out before the search was done
+};
+
+/**
+ * @brief Negamax with alpha-beta pruning, iterative deepening and a
+ * transposition table.
+ *
+ * @tparam Position Adapter around a board. It must provide:
+ *   - `typedef ... Symbol;` the board's symbol type
+ *   - `int generate_moves(MoveList<Symbol>& moves)` for the side to move,
+ *     best-looking moves first, always in the same order for a position
+ *   - `void make_move(const Move<Symbol>& m)` / `void undo_move(const Move<Symbol>& m)`
+ *   - `Outcome last_move_outcome() const` for the side that just moved
+ *   - `int evaluate() const` heuristic for the side to move, well below SEARCH_WIN
+ *   - `uint64_t key() const` hash of the position including the side to move
+ *
+ * The table is allocated on the first search. Heuristic entries from earlier
+ * searches are ignored rather than wiped, since evaluate() may depend on
+ * which side is searching; entries whose subtree reached the end of the
+ * game hold exact results and stay usable by later searches.
+ *
+ * At each node the hash move is tried first, then the two killer moves of
+ * the ply (the last moves that caused a cutoff there), then the rest by
+ * their history score (how often and how deep each move caused cutoffs),
+ * generated order breaking ties. Killers and history carry over from one
+ * search to the next, history halved each time, so consecutive moves of a
+ * game start from what the previous search learnt.
+ *
+ * With set_threads(n > 1) a search runs Lazy SMP: n - 1 helper threads
+ * search copies of the root with staggered depths and root orders, all
+ * sharing the table, and the main thread's result is returned. Each table
+ * slot is two 64-bit words written without locks; the first is the key
+ * XOR the second, so a slot torn by two threads writing at once no longer
+ * matches its key and is simply ignored. This needs copies of the
+ * Position to be independent of each other; with one thread (the default)
+ * nothing is copied and the search is deterministic.
+ */
+template <typename Position>
+class AlphaBetaSearch {
+public:
+    using Symbol = typename Position::Symbol;
+
+    /**
+     * @brief Creates an engine with a table of 2^table_bits entries.
+     */
+    explicit AlphaBetaSearch(int table_bits = 16) : table_bits(table_bits) {}
+
+    /**
+     * @brief Sets the number of threads of later searches (at least one).
+     */
+    void set_threads(int n) { threads = n < 1 ? 1 : n; }
+
+    /** @brief Number of threads a search uses. */
+    int get_threads() const { return threads; }
+
+    /**
+     * @brief Searches `pos` one ply deeper at a time up to `max_depth` plies.
+     */
+    SearchResult<Symbol> search(Position& pos, int max_depth) {
+        SearchLimits depth_only;
+        depth_only.max_depth = max_depth;
+        return search(pos, depth_only);
+    }
+
+    /**
+     * @brief Searches `pos` one ply deeper at a time until a limit is reached.
+     *
+     * Each iteration starts with the previous iteration's best move. Stops
+     * early once the result is proven, either a forced win or loss or a
+     * tree searched to the end without touching the depth limit. `pos` is
+     * restored before returning.
+     */
+    SearchResult<Symbol> search(Position& pos, const SearchLimits& search_limits) {
+        if (table.empty()) table.resize(size_t(1) << table_bits);
+        if (++generation == MAX_GENERATION) {
+            for (Slot& slot : table) slot = Slot();
+            generation = 1;
+        }
+
+        limits = search_limits;
+        if (limits.max_depth > SEARCH_MAX_PLY) limits.max_depth = SEARCH_MAX_PLY;
+        deadline = chrono::steady_clock::now() + chrono::duration_cast<chrono::steady_clock::duration>(
+                       chrono::duration<double>(limits.max_seconds));
+        shared_nodes = 0;
+        stop_all = false;
+
+        // Older history counts for less
+        while ((int)ordering.size() < threads) ordering.emplace_back(new Ordering());
+        for (auto& o : ordering)
+            for (int& h : o->history) h /= 2;
+
+        // Helpers get their own copies of the root and their own counters
+        vector<Position> copies(threads - 1, pos);
+        vector<Worker> workers(threads);
+        vector<thread> helpers;
+        workers[0].order = ordering[0].get();
+        for (int i = 1; i < threads; ++i) {
+            workers[i].id = i;
+            workers[i].order = ordering[i].get();
+            helpers.emplace_back([this, &copies, &workers, i] { iterate(copies[i - 1], workers[i], nullptr); });
+        }
+
+        SearchResult<Symbol> result;
+        iterate(pos, workers[0], &result);
+        stop_all = true;
+        for (thread& t : helpers) t.join();
+
+        for (const Worker& w : workers) result.nodes += w.nodes;
+        total_nodes += result.nodes;
+        return result;
+    }
+
+    /** @brief Positions visited by every search this engine has run. */
+    long long nodes_searched() const { return total_nodes; }
+
+    /** @brief Forgets the killer moves and history of earlier searches. */
+    void clear_ordering() { ordering.clear(); }
+
+private:
+    /** @brief Kind of bound stored with a score. */
+    enum Bound { EXACT, LOWER, UPPER };
+
+    /** @brief Depth recorded for subtrees searched to the end of the game. */
+    static const int COMPLETE = 127;
+
+    /** @brief Searches are numbered modulo this (14 bits in a slot). */
+    static const unsigned MAX_GENERATION = 1u << 14;
+
+    /**
+     * @brief One transposition table slot: `check` is the key XOR `data`.
+     *
+     * `data` packs the score (bits 0-31), depth (32-39), bound (40-41),
+     * index of the best move in generate_moves() order (42-49) and the
+     * search that stored it (50-63).
+     */
+    struct Slot {
+        atomic<uint64_t> check{0};
+        atomic<uint64_t> data{0};
+
+        Slot() = default;
+        Slot(const Slot& other) { *this = other; }
+        Slot& operator=(const Slot& other) {
+            check.store(other.check.load(memory_order_relaxed), memory_order_relaxed);
+            data.store(other.data.load(memory_order_relaxed), memory_order_relaxed);
+            return *this;
+        }
+    };
+
+    /** @brief A slot's contents, unpacked. */
+    struct Entry {
+        int score;
+        int depth;
+        Bound bound;
+        int move;
+        unsigned generation;
+    };
+
+    /** @brief History entries; moves are hashed into them. */
+    static const int HISTORY_SIZE = 1024;
+
+    /** @brief History scores are halved once one passes this. */
+    static const int HISTORY_MAX = 1 << 24;
+
+    /**
+     * @brief Move-ordering memory of one thread, kept between searches.
+     */
+    struct Ordering {
+        int history[HISTORY_SIZE] = {};
+        Move<Symbol> killers[SEARCH_MAX_PLY + 1][2];
+
+        Ordering() {
+            for (auto& ply : killers) ply[0] = ply[1] = Move<Symbol>(-1, -1, Symbol());
+        }
+    };
+
+    /** @brief Per-thread search state. */
+    struct Worker {
+        int id = 0;                ///< 0 for the main thread
+        long long nodes = 0;       ///< Positions visited
+        long long flushed = 0;     ///< Part of `nodes` already added to shared_nodes
+        long long horizon_hits = 0;///< Times the depth limit cut a line short
+        bool may_stop = false;     ///< Budgets apply (the main thread has an answer)
+        bool stopped = false;      ///< Unwinding without storing
+        Ordering* order = nullptr; ///< This thread's killers and history
+    };
+
+    int table_bits;
+    int threads = 1;
+    vector<Slot> table;           ///< Always replace; index = low bits of the key
+    vector<unique_ptr<Ordering>> ordering; ///< One per thread, kept between searches
+    unsigned generation = 0;      ///< Number of the current search
+    long long total_nodes = 0;    ///< Positions visited by all searches
+    SearchLimits limits;          ///< Limits of the current search
+    chrono::steady_clock::time_point deadline; ///< When max_seconds runs out
+    atomic<long long> shared_nodes{0}; ///< Nodes of all threads, flushed every 1024
+    atomic<bool> stop_all{false}; ///< Set when a budget runs out or the main thread is done
+
+    /**
+     * @brief Iterative deepening on one thread. The main thread fills
+     * `result`; helpers pass nullptr, start one ply deeper every other
+     * thread and rotate their root moves, so they fan out over the tree.
+     */
+    void iterate(Position& pos, Worker& w, SearchResult<Symbol>* result) {
+        MoveList<Symbol> root;
+        if (pos.generate_moves(root) == 0) return;
+        if (result) {
+            result->found = true;
+            result->best = root[0];
+        } else {
+            w.may_stop = true;
+            rotate(root.begin(), root.begin() + w.id % root.size(), root.end());
+        }
+
+        for (int depth = 1 + (w.id & 1); depth <= limits.max_depth; ++depth) {
+            long long horizon_before = w.horizon_hits;
+            int best_index = 0;
+            int alpha = -SEARCH_INF;
+
+            for (int i = 0; i < root.size() && !w.stopped; ++i) {
+                int score = child_score(pos, w, root[i], depth, 0, alpha, SEARCH_INF);
+                if (score > alpha) {
+                    alpha = score;
+                    best_index = i;
+                }
+            }
+            if (w.stopped) {
+                if (result) result->stopped = true;
+                return;
+            }
+
+            // Search the best move first next time; the rest keep their order
+            Move<Symbol> best = root[best_index];
+            for (int i = best_index; i > 0; --i) root[i] = root[i - 1];
+            root[0] = best;
+
+            if (result) {
+                result->best = best;
+                result->score = alpha;
+                result->depth = depth;
+            }
+            if (search_is_decisive(alpha) || w.horizon_hits == horizon_before) return;
+            w.may_stop = true;
+        }
+    }
+
+    /**
+     * @brief True once this thread should unwind: the main thread is done,
+     * or the node or time budget is spent. Budgets and the clock are
+     * checked every 1024 nodes only.
+     */
+    bool out_of_budget(Worker& w) {
+        if (!w.may_stop) return false;
+        if (stop_all.load(memory_order_relaxed)) return w.stopped = true;
+        if ((w.nodes & 1023) != 0) return false;
+
+        long long all = shared_nodes.fetch_add(w.nodes - w.flushed, memory_order_relaxed) + (w.nodes - w.flushed);
+        w.flushed = w.nodes;
+        if ((limits.max_nodes > 0 && all >= limits.max_nodes) ||
+            (limits.max_seconds > 0 && chrono::steady_clock::now() >= deadline)) {
+            stop_all = true;
+            w.stopped = true;
+        }
+        return w.stopped;
+    }
+
+    /**
+     * @brief Plays `m`, scores it for the side that played it, then undoes it.
+     */
+    int child_score(Position& pos, Worker& w, const Move<Symbol>& m, int depth, int ply, int alpha, int beta) {
+        pos.make_move(m);
+        int score;
+        switch (pos.last_move_outcome()) {
+            case Outcome::WIN:  score = SEARCH_WIN - (ply + 1); break;
+            case Outcome::LOSE: score = -(SEARCH_WIN - (ply + 1)); break;
+            case Outcome::DRAW: score = 0; break;
+            default:            score = -negamax(pos, w, depth - 1, ply + 1, -beta, -alpha); break;
+        }
+        pos.undo_move(m);
+        return score;
+    }
+
+    int negamax(Position& pos, Worker& w, int depth, int ply, int alpha, int beta) {
+        ++w.nodes;
+        if (w.stopped || out_of_budget(w)) return 0;
+
+        uint64_t key = pos.key();
+        Slot& slot = table[key & (table.size() - 1)];
+        Entry entry;
+        bool have_hash_move = false;
+
+        if (probe(slot, key, entry)) {
+            have_hash_move = true;
+            if (entry.depth >= depth) {
+                int score = from_table(entry.score, ply);
+                if (entry.bound == EXACT ||
+                    (entry.bound == LOWER && score >= beta) ||
+                    (entry.bound == UPPER && score <= alpha)) {
+                    if (entry.depth != COMPLETE) ++w.horizon_hits;
+                    return score;
+                }
+            }
+        }
+
+        if (depth <= 0 || ply >= SEARCH_MAX_PLY) {
+            ++w.horizon_hits;
+            return pos.evaluate();
+        }
+
+        MoveList<Symbol> moves;
+        int n = pos.generate_moves(moves);
+        if (n == 0) return 0;
+
+        // The hash move first, then killers, then history. Indices stay
+        // those of generated order, which is what the table stores.
+        Ordering& order = *w.order;
+        int hash_index = (have_hash_move && entry.move < n) ? entry.move : -1;
+        int rank[MoveList<Symbol>::CAPACITY];
+        int index[MoveList<Symbol>::CAPACITY];
+        int n_ranked = 0, next = 0;
+
+        int alpha_start = alpha;
+        long long horizon_before = w.horizon_hits;
+        int best = -SEARCH_INF;
+        int best_index = 0;
+
+        for (int k = 0; k < n; ++k) {
+            int i;
+            if (k == 0 && hash_index >= 0) {
+                i = hash_index; // Often cuts off alone, so the rest are ranked only after it
+            } else {
+                if (next == n_ranked) {
+                    // Stable insertion sort by rank; mostly ties, so nearly free
+                    const Move<Symbol>* killers = order.killers[ply];
+                    for (int j = 0; j < n; ++j) {
+                        if (j == hash_index) continue;
+                        int r;
+                        if (same_move(moves[j], killers[0])) r = HISTORY_MAX + 2;
+                        else if (same_move(moves[j], killers[1])) r = HISTORY_MAX + 1;
+                        else r = order.history[history_slot(moves[j])];
+                        int p = n_ranked++;
+                        for (; p > 0 && rank[p - 1] < r; --p) {
+                            rank[p] = rank[p - 1];
+                            index[p] = index[p - 1];
+                        }
+                        rank[p] = r;
+                        index[p] = j;
+                    }
+                }
+                i = index[next++];
+            }
+
+            int score = child_score(pos, w, moves[i], depth, ply, alpha, beta);
+            if (w.stopped) return 0;
+            if (score > best) {
+                best = score;
+                best_index = i;
+                if (score > alpha) alpha = score;
+                if (alpha >= beta) {
+                    record_cutoff(order, moves[i], depth, ply);
+                    break;
+                }
+            }
+        }
+
+        int stored_depth = (w.horizon_hits == horizon_before) ? COMPLETE : depth;
+        Bound bound = best <= alpha_start ? UPPER : (best >= beta ? LOWER : EXACT);
+        store(slot, key, to_table(best, ply), stored_depth, bound, best_index);
+        return best;
+    }
+
+    static bool same_move(const Move<Symbol>& a, const Move<Symbol>& b) {
+        return a.get_x() == b.get_x() && a.get_y() == b.get_y() && a.get_symbol() == b.get_symbol() &&
+               a.get_from_x() == b.get_from_x() && a.get_from_y() == b.get_from_y();
+    }
+
+    /** @brief History entry of a move: its squares and symbol, hashed. */
+    static int history_slot(const Move<Symbol>& m) {
+        uint64_t z = (uint64_t)hash<Symbol>()(m.get_symbol());
+        z = z * 31 + (uint64_t)(m.get_from_x() + 1);
+        z = z * 31 + (uint64_t)(m.get_from_y() + 1);
+        z = z * 31 + (uint64_t)m.get_x();
+        z = z * 31 + (uint64_t)m.get_y();
+        z *= 0x9E3779B97F4A7C15ull;
+        return (int)(z >> 54); // Top 10 bits: HISTORY_SIZE entries
+    }
+
+    /** @brief `m` refuted its position: make it a killer, raise its history. */
+    static void record_cutoff(Ordering& order, const Move<Symbol>& m, int depth, int ply) {
+        Move<Symbol>* killers = order.killers[ply];
+        if (!same_move(m, killers[0])) {
+            killers[1] = killers[0];
+            killers[0] = m;
+        }
+        int& h = order.history[history_slot(m)];
+        h += depth * depth;
+        if (h > HISTORY_MAX)
+            for (int& x : order.history) x /= 2;
+    }
+
+    /** @brief Reads `slot` into `entry` if it holds `key` and is usable now. */
+    bool probe(const Slot& slot, uint64_t key, Entry& entry) const {
+        uint64_t data = slot.data.load(memory_order_relaxed);
+        if ((slot.check.load(memory_order_relaxed) ^ data) != key) return false;
+        entry.score = (int32_t)(uint32_t)data;
+        entry.depth = (signed char)(data >> 32);
+        entry.bound = Bound((data >> 40) & 3);
+        entry.move = (int)((data >> 42) & 0xFF);
+        entry.generation = (unsigned)(data >> 50);
+        return entry.generation == generation || entry.depth == COMPLETE;
+    }
+
+    void store(Slot& slot, uint64_t key, int score, int depth, Bound bound, int move) {
+        uint64_t data = (uint64_t)(uint32_t)score | (uint64_t)(uint8_t)depth << 32 |
+                        (uint64_t)bound << 40 | (uint64_t)(uint8_t)move << 42 |
+                        (uint64_t)generation << 50;
+        slot.data.store(data, memory_order_relaxed);
+        slot.check.store(key ^ data, memory_order_relaxed);
+    }
+
+    /** @brief Win/loss scores are stored relative to the node, not the root. */
+    static int to_table(int score, int ply) {
+        if (score >= SEARCH_WIN - SEARCH_MAX_PLY) return score + ply;
+        if (score <= -(SEARCH_WIN - SEARCH_MAX_PLY)) return score - ply;
+        return score;
+    }
+
+    static int from_table(int score, int ply) {
+        if (score >= SEARCH_WIN - SEARCH_MAX_PLY) return score - ply;
+        if (score <= -(SEARCH_WIN - SEARCH_MAX_PLY)) return score + ply;
+        return score;
+    }
+};
+
+#endif // SEARCH_CLASSES_H
@@ -0,0 +1,395 @@
+/**
+ * @file SelfPlay_Classes.cpp
+ * @brief Silent computer agents and the headless catalog of all games.
+ *
+ * Every agent reproduces the "Computer" player of its game's UI, minus the
+ * console output. Random agents use their own generator instead of rand()
+ * so the seed alone decides their choices.
+ */
+
+#include "SelfPlay_Classes.h"
+#include "NUMTTT_classes.h"
+#include "XO_Classes.h"
+#include "FourInRow_Classes.h"
+#include "Misere_Classes.h"
+#include "FiveXFiveTTT_Classes.h"
+#include "FiveXFiveTTTMCTS_Classes.h"
+#include "FiveXFiveTTTSolver_Classes.h"
+#include "Infinity_Tic-Tac-Toe.h"
+#include "SUS_Classes.h"
+#include "Pyramid_Classes.h"
+#include "word_Tic-Tac-Toe.h"
+#include "DiamondTTT_Classes.h"
+#include "ultimateTTT_Classes.h"
+#include "Memory_Classes.h"
+#include "Obstacles_Tic-Tac-Toe.h"
+#include "FourByFour_Classes.h"
+#include <memory>
+#include <random>
+
+using namespace std;
+
+namespace {
+
+// -----------------------------------------------------------------------------
+// Agents
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief Plays a uniformly random legal move from the board's generator
+ * (Infinity, Memory, Ultimate and Obstacles computers).
+ */
+template <typename T>
+class RandomAgent : public Agent<T> {
+    minstd_rand rng;
+    MoveList<T> moves;
+
+public:
+    explicit RandomAgent(unsigned seed) : rng(seed) {}
+
+    Move<T>* get_move(Player<T>* player) override {
+        if (player->get_board_ptr()->generate_moves(player->get_symbol(), moves) == 0) return nullptr;
+        return this->move_slot.store(moves[rng() % moves.size()]);
+    }
+};
+
+/**
+ * @brief Plays its side's first `random_moves` moves at random, then hands
+ * over to `engine`. Most engines are deterministic, so without this every
+ * game of a pairing would be the same game.
+ */
+template <typename T>
+class OpeningAgent : public Agent<T> {
+    Agent<T>* engine;
+    RandomAgent<T> opening;
+    int random_moves;
+
+public:
+    OpeningAgent(Agent<T>* engine, int random_moves, unsigned seed)
+        : engine(engine), opening(seed), random_moves(random_moves) {}
+
+    Move<T>* get_move(Player<T>* player) override {
+        if (random_moves > 0) {
+            --random_moves;
+            return opening.get_move(player);
+        }
+        return engine->get_move(player);
+    }
+};
+
+/**
+ * @brief Solved-table lookup (XO computer).
+ */
+class XO_Agent : public Agent<char> {
+public:
+    Move<char>* get_move(Player<char>* player) override {
+        Move<char> best(0, 0, player->get_symbol());
+        if (!static_cast<X_O_Board*>(player->get_board_ptr())->get_best_move(player->get_symbol(), best)) return nullptr;
+        return move_slot.store(best);
+    }
+};
+
+/**
+ * @brief Random available number on a random empty cell (NumTTT computer).
+ */
+class NumTTT_Agent : public Agent<int> {
+    minstd_rand rng;
+
+public:
+    explicit NumTTT_Agent(unsigned seed) : rng(seed) {}
+
+    Move<int>* get_move(Player<int>* player) override {
+        NumTTT_Board* board = static_cast<NumTTT_Board*>(player->get_board_ptr());
+        const vector<int>& available = (player->get_symbol() == 1) ? board->get_odd_nums() : board->get_even_nums();
+        if (available.empty()) return nullptr;
+        int number = available[rng() % available.size()];
+
+        int empties[9];
+        int n = 0;
+        for (int i = 0; i < 9; ++i)
+            if (board->get_cell(i / 3, i % 3) == 0) empties[n++] = i;
+        if (n == 0) return nullptr;
+        int pick = empties[rng() % n];
+        return move_slot.emplace(pick / 3, pick % 3, number);
+    }
+};
+
+/**
+ * @brief Iterative-deepening alpha-beta (Four-in-a-Row computer), on a node
+ * budget instead of the UI's time budget so games are reproducible.
+ */
+class FourInRow_Agent : public Agent<char> {
+public:
+    Move<char>* get_move(Player<char>* player) override {
+        FourInRow_Board* board = static_cast<FourInRow_Board*>(player->get_board_ptr());
+        SearchLimits limits;
+        limits.max_nodes = 100000;
+        board->set_search_limits(limits);
+        int col = board->get_best_move(player->get_symbol());
+        if (col == -1) return nullptr;
+        return move_slot.emplace(0, col, player->get_symbol());
+    }
+};
+
+/**
+ * @brief Depth-limited minimax (5x5 computer).
+ */
+class FxFTTT_Agent : public Agent<char> {
+public:
+    Move<char>* get_move(Player<char>* player) override {
+        FxFTTT_board* board = static_cast<FxFTTT_board*>(player->get_board_ptr());
+        char sym = player->get_symbol();
+        board->set_ai_symbols(sym, sym == 'X' ? 'O' : 'X');
+        pair<int, int> best = board->find_best_move();
+        if (best.first == -1) return nullptr;
+        return move_slot.emplace(best.first, best.second, sym);
+    }
+};
+
+/**
+ * @brief Monte Carlo tree search (5x5 "Computer (Monte Carlo)"), on a
+ * playout budget instead of the UI's time budget.
+ */
+class FxFTTT_MCTS_Agent : public Agent<char> {
+    FxFTTT_MCTS mcts;
+
+public:
+    explicit FxFTTT_MCTS_Agent(unsigned seed) : mcts(seed) {}
+
+    Move<char>* get_move(Player<char>* player) override {
+        FxFTTT_board* board = static_cast<FxFTTT_board*>(player->get_board_ptr());
+        char sym = player->get_symbol();
+        SearchLimits limits;
+        limits.max_nodes = 20000;
+        int cell = mcts.best_cell(FxFTTT_Solver::cells_of(*board, sym),
+                                  FxFTTT_Solver::cells_of(*board, sym == 'X' ? 'O' : 'X'), limits);
+        if (cell == -1) return nullptr;
+        return move_slot.emplace(cell / 5, cell % 5, sym);
+    }
+};
+
+/**
+ * @brief Win-or-block letter search (Word Tic-Tac-Toe computer).
+ */
+class Word_Agent : public Agent<char> {
+public:
+    Move<char>* get_move(Player<char>* player) override {
+        Move<char> best = static_cast<word_xo_board*>(player->get_board_ptr())->find_best_move();
+        if (best.get_x() == -1) return nullptr;
+        return move_slot.store(best);
+    }
+};
+
+/**
+ * @brief Solved-table lookup on 3x3, a node-budget search on larger boards
+ * (Misere computer).
+ */
+class Misere_Agent : public Agent<char> {
+    unique_ptr<Misere_AIPlayer> ai; ///< Kept across moves so its search table is reused
+
+public:
+    Move<char>* get_move(Player<char>* player) override {
+        char sym = player->get_symbol();
+        if (!ai) {
+            ai.reset(new Misere_AIPlayer(player->get_name(), sym));
+            SearchLimits limits;
+            limits.max_nodes = 100000;
+            ai->set_search_limits(limits);
+        }
+        return move_slot.store(ai->choose_move(static_cast<Misere_Board*>(player->get_board_ptr()), sym == 'X' ? 'O' : 'X'));
+    }
+};
+
+/**
+ * @brief Score-or-block cell evaluation (SUS computer).
+ */
+class SUS_Agent : public Agent<char> {
+public:
+    Move<char>* get_move(Player<char>* player) override {
+        pair<int, int> best = static_cast<SUS_Board*>(player->get_board_ptr())->get_best_move(player->get_symbol());
+        if (best.first == -1) return nullptr;
+        return move_slot.emplace(best.first, best.second, player->get_symbol());
+    }
+};
+
+/**
+ * @brief Full-depth search (Pyramid computer).
+ */
+class Pyramid_Agent : public Agent<char> {
+public:
+    Move<char>* get_move(Player<char>* player) override {
+        pair<int, int> best = static_cast<Pyramid_Board*>(player->get_board_ptr())->get_best_move(player->get_symbol());
+        if (best.first == -1) return nullptr;
+        return move_slot.emplace(best.first, best.second, player->get_symbol());
+    }
+};
+
+/**
+ * @brief Full-depth search (Diamond computer).
+ */
+class Diamond_Agent : public Agent<char> {
+    unique_ptr<Diamond_AIPlayer> ai; ///< Kept across moves so its table is reused
+
+public:
+    Move<char>* get_move(Player<char>* player) override {
+        char sym = player->get_symbol();
+        if (!ai) ai.reset(new Diamond_AIPlayer(player->get_name(), sym));
+        return move_slot.store(ai->choose_move(static_cast<Diamond_Board*>(player->get_board_ptr()), sym == 'X' ? 'O' : 'X'));
+    }
+};
+
+/**
+ * @brief Depth-6 search over sliding moves (4x4 computer).
+ */
+class FourByFour_Agent : public Agent<char> {
+    MoveSlot<FourByFour_Move> slide_slot;
+
+public:
+    Move<char>* get_move(Player<char>* player) override {
+        FourByFour_Board* board = static_cast<FourByFour_Board*>(player->get_board_ptr());
+        return slide_slot.store(board->find_best_move(player->get_symbol(), 6));
+    }
+};
+
+// -----------------------------------------------------------------------------
+// Catalog
+// -----------------------------------------------------------------------------
+
+/** @brief Second seed derived from the first so both sides differ. */
+unsigned other_seed(unsigned seed) { return seed * 2654435761u + 0x9E3779B9u; }
+
+/** @brief Random moves each side plays before its engine takes over. */
+const int OPENING_MOVES = 1;
+
+/**
+ * @brief Plays one game of `board` between two agents, after a seeded random
+ * opening of OPENING_MOVES moves per side.
+ */
+template <typename T>
+SelfPlayResult play_game(Board<T>& board, T sym_x, T sym_o,
+                         Agent<T>* agent_x, Agent<T>* agent_o,
+                         unsigned seed, vector<long long>* move_ns) {
+    Player<T> player_x("Player X", sym_x, PlayerType::COMPUTER);
+    Player<T> player_o("Player O", sym_o, PlayerType::COMPUTER);
+    Player<T>* players[2] = {&player_x, &player_o};
+    OpeningAgent<T> opening_x(agent_x, OPENING_MOVES, ~seed);
+    OpeningAgent<T> opening_o(agent_o, OPENING_MOVES, ~other_seed(seed));
+    Agent<T>* agents[2] = {&opening_x, &opening_o};
+    SelfPlayManager<T> manager(&board, players, agents);
+    return manager.run(move_ns);
+}
+
+SelfPlayResult play_numerical(int, int, unsigned seed, vector<long long>* move_ns) {
+    NumTTT_Board board;
+    NumTTT_Agent x(seed), o(other_seed(seed));
+    return play_game<int>(board, 1, 2, &x, &o, seed, move_ns);
+}
+
+SelfPlayResult play_xo(int engine_x, int engine_o, unsigned seed, vector<long long>* move_ns) {
+    X_O_Board board;
+    XO_Agent table_x, table_o;
+    RandomAgent<char> random_x(seed), random_o(other_seed(seed));
+    Agent<char>* x = engine_x == 1 ? (Agent<char>*)&random_x : &table_x;
+    Agent<char>* o = engine_o == 1 ? (Agent<char>*)&random_o : &table_o;
+    return play_game<char>(board, 'X', 'O', x, o, seed, move_ns);
+}
+
+SelfPlayResult play_four_in_row(int, int, unsigned seed, vector<long long>* move_ns) {
+    FourInRow_Board board;
+    board.set_opening_book(nullptr); // Same play whatever file sits in the working directory
+    FourInRow_Agent x, o;
+    return play_game<char>(board, 'X', 'O', &x, &o, seed, move_ns);
+}
+
+SelfPlayResult play_five_by_five(int engine_x, int engine_o, unsigned seed, vector<long long>* move_ns) {
+    FxFTTT_board board;
+    board.set_database(nullptr); // Same play whatever file sits in the working directory
+    FxFTTT_Agent search_x, search_o;
+    FxFTTT_MCTS_Agent mcts_x(seed), mcts_o(other_seed(seed));
+    Agent<char>* x = engine_x == 1 ? (Agent<char>*)&mcts_x : &search_x;
+    Agent<char>* o = engine_o == 1 ? (Agent<char>*)&mcts_o : &search_o;
+    return play_game<char>(board, 'X', 'O', x, o, seed, move_ns);
+}
+
+SelfPlayResult play_word(int, int, unsigned seed, vector<long long>* move_ns) {
+    word_xo_board board;
+    Word_Agent x, o;
+    return play_game<char>(board, 'X', 'O', &x, &o, seed, move_ns);
+}
+
+SelfPlayResult play_misere(int, int, unsigned seed, vector<long long>* move_ns) {
+    Misere_Board board;
+    Misere_Agent x, o;
+    return play_game<char>(board, 'X', 'O', &x, &o, seed, move_ns);
+}
+
+SelfPlayResult play_sus(int, int, unsigned seed, vector<long long>* move_ns) {
+    SUS_Board board;
+    board.set_player_letters('S', 'U');
+    SUS_Agent x, o;
+    return play_game<char>(board, 'S', 'U', &x, &o, seed, move_ns);
+}
+
+SelfPlayResult play_pyramid(int, int, unsigned seed, vector<long long>* move_ns) {
+    Pyramid_Board board;
+    Pyramid_Agent x, o;
+    return play_game<char>(board, 'X', 'O', &x, &o, seed, move_ns);
+}
+
+SelfPlayResult play_infinity(int, int, unsigned seed, vector<long long>* move_ns) {
+    inf_xo_Board board;
+    RandomAgent<char> x(seed), o(other_seed(seed));
+    return play_game<char>(board, 'X', 'O', &x, &o, seed, move_ns);
+}
+
+SelfPlayResult play_diamond(int, int, unsigned seed, vector<long long>* move_ns) {
+    Diamond_Board board;
+    Diamond_Agent x, o;
+    return play_game<char>(board, 'X', 'O', &x, &o, seed, move_ns);
+}
+
+SelfPlayResult play_ultimate(int, int, unsigned seed, vector<long long>* move_ns) {
+    Ultimate_Board board;
+    RandomAgent<char> x(seed), o(other_seed(seed));
+    return play_game<char>(board, 'X', 'O', &x, &o, seed, move_ns);
+}
+
+SelfPlayResult play_memory(int, int, unsigned seed, vector<long long>* move_ns) {
+    Memory_Board board;
+    RandomAgent<char> x(seed), o(other_seed(seed));
+    return play_game<char>(board, 'X', 'O', &x, &o, seed, move_ns);
+}
+
+SelfPlayResult play_obstacles(int, int, unsigned seed, vector<long long>* move_ns) {
+    obstacles_TTT_board board(seed);
+    RandomAgent<char> x(seed), o(other_seed(seed));
+    return play_game<char>(board, 'X', 'O', &x, &o, seed, move_ns);
+}
+
+SelfPlayResult play_four_by_four(int, int, unsigned seed, vector<long long>* move_ns) {
+    FourByFour_Board board;
+    FourByFour_Agent x, o;
+    return play_game<char>(board, 'X', 'O', &x, &o, seed, move_ns);
+}
+
+} // namespace
+
+const vector<SelfPlayGame>& self_play_games() {
+    static const vector<SelfPlayGame> games = {
+        {"Numerical Tic-Tac-Toe",     {"computer"}, play_numerical},
+        {"3*3 Tic-Tac-Toe",           {"computer", "random"}, play_xo},
+        {"Four-in-a-Row",             {"computer"}, play_four_in_row},
+        {"5*5 Tic-Tac-Toe",           {"computer", "mcts"}, play_five_by_five},
+        {"word Tic-Tac-Toe",          {"computer"}, play_word},
+        {"Misere Tic-Tac-Toe(3x3)",   {"computer"}, play_misere},
+        {"SUS",                       {"computer"}, play_sus},
+        {"Pyramid Tic-Tac-Toe",       {"computer"}, play_pyramid},
+        {"Infinite Tic-Tac-Toe",      {"computer"}, play_infinity},
+        {"Diamond Tic-Tac-Toe",       {"computer"}, play_diamond},
+        {"Ultimate Tic-Tac-Toe",      {"computer"}, play_ultimate},
+        {"Memory Tic-Tac-Toe",        {"computer"}, play_memory},
+        {"Obstacles Tic-Tac-Toe",     {"computer"}, play_obstacles},
+        {"FourByFour Tic-Tac-Toe",    {"computer"}, play_four_by_four},
+    };
+    return games;
+}
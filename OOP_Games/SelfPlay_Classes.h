@@ -0,0 +1,81 @@
+/**
+ * @file SelfPlay_Classes.h
+ * @brief Headless self-play for every game in the Game Center.
+ *
+ * Each catalog entry knows how to build its board and computer agents and
+ * play one complete game through SelfPlayManager, with no prompts and no
+ * board rendering. Used for regression and strength testing. Each side's
+ * first move is a seeded random one, so deterministic engines still play a
+ * different game for each seed.
+ */
+
+#ifndef SELFPLAY_CLASSES_H
+#define SELFPLAY_CLASSES_H
+
+#include "BoardGame_Classes.h"
+#include <iostream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/**
+ * @struct SelfPlayGame
+ * @brief One game of the catalog, in the same order as the main menu.
+ */
+struct SelfPlayGame {
+    string name;            ///< Game name as shown in the main menu.
+    vector<string> engines; ///< Names of the agents available for this game.
+
+    /**
+     * @brief Plays one headless game.
+     * @param engine_x Index in `engines` of the agent playing first.
+     * @param engine_o Index in `engines` of the agent playing second.
+     * @param seed Seed for the random opening, the agents' random choices
+     * and the board's own randomness, such as Obstacles' drops (same seed,
+     * same game).
+     * @param move_ns Optional buffer receiving the time of every move.
+     * @return Result record of the game.
+     */
+    SelfPlayResult (*play)(int engine_x, int engine_o, unsigned seed, vector<long long>* move_ns);
+};
+
+/**
+ * @brief Returns the catalog of all 14 games.
+ */
+const vector<SelfPlayGame>& self_play_games();
+
+/**
+ * @class NullBuffer
+ * @brief Stream buffer that drops every character. Keeps no state, so any
+ * number of threads can write through it at once.
+ */
+class NullBuffer : public streambuf {
+protected:
+    int overflow(int c) override { return traits_type::not_eof(c); }
+    streamsize xsputn(const char*, streamsize n) override { return n; }
+};
+
+/**
+ * @class ScopedSilence
+ * @brief Discards everything written to `cout` while alive.
+ *
+ * Some boards report events (scores, rejected moves) directly on `cout`.
+ * Install one of these around a batch of headless games. The games may run
+ * on several threads, but create and destroy the silence from one thread
+ * while no game is running.
+ */
+class ScopedSilence {
+    NullBuffer sink;  ///< Replacement buffer.
+    streambuf* saved; ///< Original buffer of `cout`.
+
+public:
+    ScopedSilence() : saved(cout.rdbuf(&sink)) {}
+    ~ScopedSilence() { cout.rdbuf(saved); }
+
+    ScopedSilence(const ScopedSilence&) = delete;
+    ScopedSilence& operator=(const ScopedSilence&) = delete;
+};
+
+#endif // SELFPLAY_CLASSES_H
@@ -0,0 +1,210 @@
+/**
+ * @file Tournament_Classes.cpp
+ * @brief Work-stealing pool and round-robin tournament implementation.
+ */
+
+#include "Tournament_Classes.h"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+
+using namespace std;
+
+// -----------------------------------------------------------------------------
+// WorkStealingPool Implementation
+// -----------------------------------------------------------------------------
+
+namespace {
+thread_local const WorkStealingPool* current_pool = nullptr; ///< Pool owning this thread, if any.
+thread_local int current_worker = -1;                        ///< Worker index inside that pool.
+}
+
+WorkStealingPool::WorkStealingPool(int n_threads) {
+    n_threads = max(1, n_threads);
+    for (int i = 0; i < n_threads; ++i)
+        queues.push_back(make_unique<Queue>());
+    for (int i = 0; i < n_threads; ++i)
+        threads.emplace_back(&WorkStealingPool::worker_loop, this, i);
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    wait();
+    {
+        lock_guard<mutex> guard(sleep_lock);
+        stopping = true;
+    }
+    work_ready.notify_all();
+    for (thread& t : threads) t.join();
+}
+
+void WorkStealingPool::submit(Task task) {
+    int target = (current_pool == this)
+        ? current_worker
+        : (int)(next_queue.fetch_add(1, memory_order_relaxed) % queues.size());
+
+    pending.fetch_add(1);
+    {
+        lock_guard<mutex> guard(queues[target]->lock);
+        queues[target]->tasks.push_back(move(task));
+    }
+    queued.fetch_add(1);
+
+    // Taking the lock orders this notify after a sleeping worker's check.
+    lock_guard<mutex> guard(sleep_lock);
+    work_ready.notify_one();
+}
+
+void WorkStealingPool::wait() {
+    unique_lock<mutex> guard(sleep_lock);
+    all_done.wait(guard, [this] { return pending.load() == 0; });
+}
+
+bool WorkStealingPool::pop_local(int id, Task& task) {
+    Queue& own = *queues[id];
+    lock_guard<mutex> guard(own.lock);
+    if (own.tasks.empty()) return false;
+    task = move(own.tasks.back());
+    own.tasks.pop_back();
+    queued.fetch_sub(1);
+    return true;
+}
+
+bool WorkStealingPool::steal(int id, Task& task) {
+    int n = (int)queues.size();
+    for (int k = 1; k < n; ++k) {
+        Queue& victim = *queues[(id + k) % n];
+        lock_guard<mutex> guard(victim.lock);
+        if (victim.tasks.empty()) continue;
+        task = move(victim.tasks.front());
+        victim.tasks.pop_front();
+        queued.fetch_sub(1);
+        return true;
+    }
+    return false;
+}
+
+void WorkStealingPool::worker_loop(int id) {
+    current_pool = this;
+    current_worker = id;
+
+    while (true) {
+        Task task;
+        if (pop_local(id, task) || steal(id, task)) {
+            task(id);
+            if (pending.fetch_sub(1) == 1) {
+                lock_guard<mutex> guard(sleep_lock);
+                all_done.notify_all();
+            }
+            continue;
+        }
+
+        unique_lock<mutex> guard(sleep_lock);
+        work_ready.wait(guard, [this] { return stopping || queued.load() > 0; });
+        if (stopping && queued.load() == 0) return;
+    }
+}
+
+// -----------------------------------------------------------------------------
+// EngineStats Implementation
+// -----------------------------------------------------------------------------
+
+void EngineStats::merge(const EngineStats& other) {
+    games += other.games;
+    wins += other.wins;
+    draws += other.draws;
+    losses += other.losses;
+    moves += other.moves;
+    move_ns += other.move_ns;
+    game_ns += other.game_ns;
+}
+
+// -----------------------------------------------------------------------------
+// Tournament Implementation
+// -----------------------------------------------------------------------------
+
+Tournament::Tournament(const TournamentOptions& options) : options(options) {
+    const vector<SelfPlayGame>& catalog = self_play_games();
+    int n_slots = 0;
+    for (const SelfPlayGame& game : catalog) {
+        first_slot.push_back(n_slots);
+        n_slots += (int)game.engines.size();
+    }
+    totals.assign(n_slots, EngineStats());
+
+    if (this->options.games.empty())
+        for (int g = 0; g < (int)catalog.size(); ++g) this->options.games.push_back(g);
+}
+
+void Tournament::run() {
+    const vector<SelfPlayGame>& catalog = self_play_games();
+    threads_used = options.threads > 0 ? options.threads : max(1, (int)thread::hardware_concurrency());
+
+    // Each worker adds into its own copy; they are merged once at the end.
+    vector<vector<EngineStats>> per_worker(threads_used, vector<EngineStats>(totals.size()));
+    games_played = 0;
+
+    auto start = chrono::steady_clock::now();
+    {
+        ScopedSilence quiet;
+        WorkStealingPool pool(threads_used);
+        unsigned seed = options.seed;
+
+        for (int g : options.games) {
+            int n_engines = (int)catalog[g].engines.size();
+            for (int i = 0; i < n_engines; ++i)
+                for (int j = 0; j < n_engines; ++j)
+                    for (int k = 0; k < options.games_per_pairing; ++k, ++seed, ++games_played) {
+                        pool.submit([&, g, i, j, seed](int w) {
+                            auto t0 = chrono::steady_clock::now();
+                            SelfPlayResult r = catalog[g].play(i, j, seed, nullptr);
+                            long long ns = chrono::duration_cast<chrono::nanoseconds>(
+                                chrono::steady_clock::now() - t0).count();
+
+                            EngineStats& x = per_worker[w][slot(g, i)];
+                            EngineStats& o = per_worker[w][slot(g, j)];
+                            x.games++;
+                            o.games++;
+                            x.game_ns += ns;
+                            o.game_ns += ns;
+                            x.moves += (r.n_moves + 1) / 2;
+                            o.moves += r.n_moves / 2;
+                            x.move_ns += r.think_ns[0];
+                            o.move_ns += r.think_ns[1];
+                            if (r.winner == 0) { x.wins++; o.losses++; }
+                            else if (r.winner == 1) { o.wins++; x.losses++; }
+                            else { x.draws++; o.draws++; }
+                        });
+                    }
+        }
+        pool.wait();
+    }
+    wall_seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    for (EngineStats& s : totals) s = EngineStats();
+    for (const vector<EngineStats>& worker : per_worker)
+        for (size_t s = 0; s < totals.size(); ++s) totals[s].merge(worker[s]);
+}
+
+void Tournament::print(ostream& out) const {
+    const vector<SelfPlayGame>& catalog = self_play_games();
+
+    out << games_played << " games on " << threads_used << " threads in "
+        << fixed << setprecision(3) << wall_seconds << " s ("
+        << setprecision(1) << (wall_seconds > 0 ? games_played / wall_seconds : 0) << " games/s)\n\n";
+
+    out << left << setw(26) << "Game" << setw(12) << "Engine"
+        << right << setw(9) << "Games" << setw(8) << "W" << setw(8) << "D" << setw(8) << "L"
+        << setw(14) << "Games/s/core" << setw(16) << "Mean move (us)" << "\n";
+
+    for (int g : options.games) {
+        for (int e = 0; e < (int)catalog[g].engines.size(); ++e) {
+            const EngineStats& s = stats(g, e);
+            double per_core = s.game_ns > 0 ? s.games * 1e9 / s.game_ns : 0;
+            double mean_us = s.moves > 0 ? s.move_ns / 1e3 / s.moves : 0;
+            out << left << setw(26) << catalog[g].name << setw(12) << catalog[g].engines[e]
+                << right << setw(9) << s.games << setw(8) << s.wins << setw(8) << s.draws
+                << setw(8) << s.losses << setw(14) << setprecision(1) << per_core
+                << setw(16) << setprecision(3) << mean_us << "\n";
+        }
+    }
+}
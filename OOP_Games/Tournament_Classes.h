@@ -0,0 +1,151 @@
+/**
+ * @file Tournament_Classes.h
+ * @brief Parallel round-robin tournaments between the computer agents.
+ *
+ * Games are scheduled one task per game on a work-stealing thread pool, so
+ * a core that finishes a batch of cheap 3x3 games picks up the leftovers of
+ * a core stuck on 5x5 searches instead of sitting idle.
+ */
+
+#ifndef TOURNAMENT_CLASSES_H
+#define TOURNAMENT_CLASSES_H
+
+#include "SelfPlay_Classes.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+/**
+ * @class WorkStealingPool
+ * @brief Fixed set of worker threads, each with its own task deque.
+ *
+ * A worker pops its newest task from the back of its own deque. When that
+ * is empty it steals the oldest task from the front of another worker's
+ * deque. Tasks receive the index of the worker running them so they can
+ * write into per-worker buffers without locking.
+ */
+class WorkStealingPool {
+public:
+    using Task = function<void(int worker)>;
+
+    /**
+     * @brief Starts the worker threads.
+     * @param n_threads Number of workers (at least one).
+     */
+    explicit WorkStealingPool(int n_threads);
+
+    /**
+     * @brief Finishes every queued task, then joins the workers.
+     */
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    /**
+     * @brief Queues a task. From a worker thread it goes to that worker's own
+     * deque, otherwise the deques are filled in turn.
+     */
+    void submit(Task task);
+
+    /**
+     * @brief Blocks until every submitted task has finished.
+     */
+    void wait();
+
+    /** @brief Returns the number of workers. */
+    int size() const { return (int)threads.size(); }
+
+private:
+    /** @brief One worker's deque and the lock guarding it. */
+    struct Queue {
+        mutex lock;
+        deque<Task> tasks;
+    };
+
+    vector<unique_ptr<Queue>> queues; ///< One deque per worker.
+    vector<thread> threads;           ///< Worker threads.
+    atomic<int> queued{0};            ///< Tasks sitting in any deque.
+    atomic<int> pending{0};           ///< Tasks submitted and not yet finished.
+    atomic<unsigned> next_queue{0};   ///< Round-robin target for outside submits.
+    bool stopping = false;            ///< Set once by the destructor.
+
+    mutex sleep_lock;                 ///< Guards the two condition variables.
+    condition_variable work_ready;    ///< Signalled when a task is queued.
+    condition_variable all_done;      ///< Signalled when `pending` reaches zero.
+
+    void worker_loop(int id);
+    bool pop_local(int id, Task& task);
+    bool steal(int id, Task& task);
+};
+
+/**
+ * @struct EngineStats
+ * @brief Totals of one engine in one game of the catalog.
+ */
+struct EngineStats {
+    long long games = 0;   ///< Games played, either side.
+    long long wins = 0;
+    long long draws = 0;
+    long long losses = 0;
+    long long moves = 0;   ///< Moves made by this engine.
+    long long move_ns = 0; ///< Time spent choosing those moves.
+    long long game_ns = 0; ///< Wall time of the games it played.
+
+    /** @brief Adds another set of totals to this one. */
+    void merge(const EngineStats& other);
+};
+
+/**
+ * @struct TournamentOptions
+ * @brief What to play and how.
+ */
+struct TournamentOptions {
+    vector<int> games;         ///< Catalog indices (0-based) to play; empty means all.
+    int games_per_pairing = 100; ///< Games per ordered (first, second) engine pair.
+    int threads = 0;           ///< Worker threads; 0 means one per core.
+    unsigned seed = 1;         ///< Seed of the first game; later games count up.
+};
+
+/**
+ * @class Tournament
+ * @brief Round-robin between every ordered pair of engines of each game.
+ */
+class Tournament {
+public:
+    explicit Tournament(const TournamentOptions& options);
+
+    /**
+     * @brief Plays every scheduled game and collects the statistics.
+     */
+    void run();
+
+    /**
+     * @brief Prints W/D/L, games per second and mean move latency per engine.
+     */
+    void print(ostream& out) const;
+
+    /** @brief Statistics of engine `engine` in catalog game `game`. */
+    const EngineStats& stats(int game, int engine) const { return totals[slot(game, engine)]; }
+
+private:
+    TournamentOptions options;
+    vector<int> first_slot;     ///< Index in `totals` of each game's first engine.
+    vector<EngineStats> totals; ///< Merged statistics, one per (game, engine).
+    long long games_played = 0;
+    double wall_seconds = 0;
+    int threads_used = 0;
+
+    int slot(int game, int engine) const { return first_slot[game] + engine; }
+};
+
+#endif // TOURNAMENT_CLASSES_H
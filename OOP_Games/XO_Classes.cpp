@@ -3,17 +3,97 @@
 #include <iostream>
 #include <iomanip>
 #include <cctype>  // for toupper()
+#include <cstdlib>
 #include "XO_Classes.h"
 
 using namespace std;
 
+//--------------------------------------- Win masks and solved positions
+
+namespace {
+
+constexpr int WIN_MASKS[8] = {0007, 0070, 0700, 0111, 0222, 0444, 0421, 0124}; // Rows, columns, diagonals
+constexpr int ORDER[9] = {4, 0, 2, 6, 8, 1, 3, 5, 7}; // Centre, corners, edges
+constexpr int FULL = 0777;
+
+constexpr bool has_win(int mask) {
+    for (int line : WIN_MASKS)
+        if ((mask & line) == line) return true;
+    return false;
+}
+
+int side_index(char symbol) { return symbol == 'X' ? 0 : 1; }
+
+/**
+ * A position is coded in base 3 from the side to move's point of view:
+ * BASE3[mine] + 2 * BASE3[theirs], so digit i (cell r * 3 + c) is 0 for
+ * empty, 1 for the side to move and 2 for the opponent.
+ */
+constexpr int POSITIONS = 19683; // 3^9
+
+struct Base3 {
+    int of[512] = {};
+    constexpr Base3() {
+        for (int mask = 0; mask < 512; ++mask)
+            for (int i = 8; i >= 0; --i) of[mask] = of[mask] * 3 + (mask >> i & 1);
+    }
+};
+
+constexpr Base3 BASE3;
+
+/**
+ * An entry packs `SOLVED | (score + 16) << 4 | cell`. A score is for the
+ * side to move: 10 - n if it completes a line when n cells are full
+ * (sooner is better), minus that if the opponent does, 0 for a draw.
+ */
+constexpr uint16_t SOLVED = 0x8000;
+
+struct XO_Table {
+    uint16_t entry[POSITIONS] = {};
+};
+
+constexpr int solve(XO_Table& table, int mine, int theirs) {
+    int code = BASE3.of[mine] + 2 * BASE3.of[theirs];
+    if (table.entry[code] & SOLVED) return ((table.entry[code] >> 4) & 0x1F) - 16;
+
+    int filled = 0;
+    for (int i = 0; i < 9; ++i) filled += (mine | theirs) >> i & 1;
+
+    int best = -100, best_cell = 0;
+    for (int cell : ORDER) {
+        if ((mine | theirs) >> cell & 1) continue;
+        int after = mine | (1 << cell);
+        int score = 0;
+        if (has_win(after)) score = 10 - (filled + 1);
+        else if (filled == 8) score = 0;
+        else score = -solve(table, theirs, after);
+        if (score > best) {
+            best = score;
+            best_cell = cell;
+        }
+    }
+    table.entry[code] = uint16_t(SOLVED | (best + 16) << 4 | best_cell);
+    return best;
+}
+
+/** @brief Every position reachable from the empty board, solved. */
+constexpr XO_Table solve_all() {
+    XO_Table table;
+    solve(table, 0, 0);
+    return table;
+}
+
+constexpr XO_Table XO_TABLE = solve_all();
+
+static_assert(((XO_TABLE.entry[0] >> 4) & 0x1F) == 16, "Tic-Tac-Toe is a draw with perfect play");
+
+} // namespace
+
 //--------------------------------------- X_O_Board Implementation
 
 X_O_Board::X_O_Board() : Board(3, 3) {
     // Initialize all cells with blank_symbol
-    for (auto& row : board)
-        for (auto& cell : row)
-            cell = blank_symbol;
+    fill_cells(blank_symbol);
 }
 
 bool X_O_Board::update_board(Move<char>* move) {
@@ -23,41 +103,33 @@ bool X_O_Board::update_board(Move<char>* move) {
 
     // Validate move and apply if valid
     if (!(x < 0 || x >= rows || y < 0 || y >= columns) &&
-        (board[x][y] == blank_symbol || mark == 0)) {
+        (cell(x, y) == blank_symbol || mark == 0)) {
 
         if (mark == 0) { // Undo move
             n_moves--;
-            board[x][y] = blank_symbol;
+            place(x, y, blank_symbol);
+            record_move(-1, -1);
         }
         else {         // Apply move
             n_moves++;
-            board[x][y] = toupper(mark);
+            place(x, y, toupper(mark));
+            record_move(x, y);
         }
         return true;
     }
     return false;
 }
 
-bool X_O_Board::is_win(Player<char>* player) {
-    const char sym = player->get_symbol();
-
-    auto all_equal = [&](char a, char b, char c) {
-        return a == b && b == c && a != blank_symbol;
-        };
-
-    // Check rows and columns
-    for (int i = 0; i < rows; ++i) {
-        if ((all_equal(board[i][0], board[i][1], board[i][2]) && board[i][0] == sym) ||
-            (all_equal(board[0][i], board[1][i], board[2][i]) && board[0][i] == sym))
-            return true;
-    }
-
-    // Check diagonals
-    if ((all_equal(board[0][0], board[1][1], board[2][2]) && board[1][1] == sym) ||
-        (all_equal(board[0][2], board[1][1], board[2][0]) && board[1][1] == sym))
-        return true;
+void X_O_Board::place(int x, int y, char symbol) {
+    char old = cell(x, y);
+    int bit = 1 << (x * 3 + y);
+    if (old != blank_symbol) marks[side_index(old)] &= ~bit;
+    if (symbol != blank_symbol) marks[side_index(symbol)] |= bit;
+    set_cell(x, y, symbol);
+}
 
-    return false;
+bool X_O_Board::is_win(Player<char>* player) {
+    return has_win(get_marks(player->get_symbol()));
 }
 
 bool X_O_Board::is_draw(Player<char>* player) {
@@ -68,6 +140,37 @@ bool X_O_Board::game_is_over(Player<char>* player) {
     return is_win(player) || is_draw(player);
 }
 
+int X_O_Board::generate_moves(char symbol, MoveList<char>& moves) const {
+    moves.clear();
+    for (int empty = ~(marks[0] | marks[1]) & FULL; empty; empty &= empty - 1) {
+        int i = __builtin_ctz(empty);
+        moves.add(i / 3, i % 3, symbol);
+    }
+    return moves.size();
+}
+
+Outcome X_O_Board::evaluate_last_move(Player<char>* player) {
+    // Any new line has to pass through the cell just played
+    int mine = get_marks(player->get_symbol());
+    int last = 1 << (last_x * 3 + last_y);
+    for (int line : WIN_MASKS)
+        if ((line & last) && (mine & line) == line) return Outcome::WIN;
+    if (n_moves == 9) return Outcome::DRAW;
+    return Outcome::ONGOING;
+}
+
+bool X_O_Board::get_best_move(char symbol, Move<char>& best, int* score) const {
+    int mine = get_marks(symbol), theirs = marks[1 - side_index(symbol)];
+    if ((mine | theirs) == FULL || has_win(mine) || has_win(theirs)) return false;
+
+    uint16_t entry = XO_TABLE.entry[BASE3.of[mine] + 2 * BASE3.of[theirs]];
+    if (!(entry & SOLVED)) return false; // Not reachable in a game (e.g. too many marks of one side)
+    int cell = entry & 0xF, value = ((entry >> 4) & 0x1F) - 16;
+    best = Move<char>(cell / 3, cell % 3, symbol);
+    if (score) *score = (value > 0) - (value < 0);
+    return true;
+}
+
 //--------------------------------------- XO_UI Implementation ------------------------------------------------
 
 XO_UI::XO_UI() : UI<char>("", 3) {}
@@ -81,15 +184,21 @@ Player<char>* XO_UI::create_player(string& name, char symbol, PlayerType type) {
 }
 
 Move<char>* XO_UI::get_move(Player<char>* player) {
-    int x, y;
+    int x = 0, y = 0;
 
     if (player->get_type() == PlayerType::HUMAN) {
         cout << "\nPlease enter your move x and y (0 to 2): ";
         cin >> x >> y;
     }
     else if (player->get_type() == PlayerType::COMPUTER) {
-        x = rand() % player->get_board_ptr()->get_rows();
-        y = rand() % player->get_board_ptr()->get_columns();
+        X_O_Board* board = dynamic_cast<X_O_Board*>(player->get_board_ptr());
+        Move<char> best(0, 0, player->get_symbol());
+        if (board && board->get_best_move(player->get_symbol(), best)) return move_slot.store(best);
+
+        // A random empty cell, drawn once instead of retried until one is free
+        MoveList<char> moves;
+        if (player->get_board_ptr()->generate_moves(player->get_symbol(), moves) > 0)
+            return move_slot.store(moves[rand() % moves.size()]);
     }
-    return new Move<char>(x, y, player->get_symbol());
+    return move_slot.emplace(x, y, player->get_symbol());
 }
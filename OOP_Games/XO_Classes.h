@@ -11,6 +11,7 @@
 #define XO_CLASSES_H
 
 #include "BoardGame_Classes.h"
+#include <cstdint>
 using namespace std;
 
 /**
@@ -21,12 +22,25 @@ using namespace std;
  * the specific logic required for the Tic-Tac-Toe (X-O) game, including
  * move updates, win/draw detection, and display functions.
  *
+ * Besides the cells, each side's marks are kept as a 9-bit mask (bit
+ * r * 3 + c), so a win is one of 8 mask compares and the empty cells are
+ * one complement.
+ *
  * @see Board
  */
 class X_O_Board : public Board<char> {
 private:
     char blank_symbol = '.'; ///< Character used to represent an empty cell on the board.
 
+protected:
+    uint16_t marks[2] = {}; ///< Cells of X and of O
+
+    /**
+     * @brief Writes a cell through set_cell(), keeping `marks` in step.
+     * Derived boards change cells only through this.
+     */
+    void place(int x, int y, char symbol);
+
 public:
     /**
      * @brief Default constructor that initializes a 3x3 X-O board.
@@ -67,6 +81,31 @@ public:
      * @return true if the game has ended, false otherwise.
      */
     bool game_is_over(Player<char>* player);
+
+    /**
+     * @brief Win if a line runs through the last move, draw once the board is full.
+     */
+    Outcome evaluate_last_move(Player<char>* player) override;
+
+    /**
+     * @brief Every empty cell.
+     */
+    int generate_moves(char symbol, MoveList<char>& moves) const override;
+
+    /** @brief Cells of `symbol` as a 9-bit mask (bit r * 3 + c). */
+    int get_marks(char symbol) const { return marks[symbol == 'X' ? 0 : 1]; }
+
+    /**
+     * @brief The perfect-play move for `symbol`, from a table of every
+     * position solved at compile time.
+     *
+     * Among equal moves the centre comes first, then corners, then edges;
+     * a win is taken as soon as possible and a loss put off as long as possible.
+     * @param best Receives the move.
+     * @param score Optional, receives +1 for a forced win, -1 for a forced loss, 0 for a draw.
+     * @return false if there is nothing to play (game over, or not a standard game).
+     */
+    virtual bool get_best_move(char symbol, Move<char>& best, int* score = nullptr) const;
 };
 
 
@@ -104,6 +143,9 @@ public:
 
     /**
      * @brief Retrieves the next move from a player.
+     *
+     * The computer plays X_O_Board::get_best_move(); on boards without a
+     * solved table (Infinity) it picks a random empty cell.
      * @param player Pointer to the player whose move is being requested.
      * @return A pointer to a new `Move<char>` object representing the player's action.
      */
@@ -0,0 +1,47 @@
+/**
+ * @file bench.cpp
+ * @brief Command-line runner for the board micro-benchmarks.
+ *
+ * Usage: bench [-t min_seconds_per_case] [game ...]
+ *
+ * Games are numbered as in the main menu (1-14); with none given, every
+ * game is benchmarked. Results go to stdout as CSV.
+ */
+
+#include "Bench_Classes.h"
+#include "SelfPlay_Classes.h"
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+using namespace std;
+
+/**
+ * @brief Parses the options, runs the selected cases and prints them.
+ * @return 0 on success, 1 on bad arguments.
+ */
+int main(int argc, char* argv[]) {
+    double min_seconds = 0.2;
+    int n_games = (int)self_play_games().size();
+    vector<bool> selected(n_games, false);
+    bool any = false;
+
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "-t") == 0 && i + 1 < argc) {
+            min_seconds = atof(argv[++i]);
+        } else {
+            int game = atoi(argv[i]);
+            if (game < 1 || game > n_games) {
+                cerr << "Usage: bench [-t min_seconds_per_case] [game 1-" << n_games << " ...]\n";
+                return 1;
+            }
+            selected[game - 1] = any = true;
+        }
+    }
+
+    vector<BenchResult> results;
+    for (const BenchCase& c : bench_cases())
+        if (!any || selected[c.game]) results.push_back(run_bench(c, min_seconds));
+    print_bench_csv(cout, results);
+    return 0;
+}
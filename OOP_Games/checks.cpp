@@ -0,0 +1,503 @@
+/**
+ * @file checks.cpp
+ * @brief Equivalence checks of the fast game code against plain references.
+ *
+ * Usage: checks [outcome|connect4|triples|solver|database ...]
+ *
+ * Each check plays a few hundred seeded random positions and compares:
+ * - outcome:  Board::get_outcome() with the old is_win / is_lose / is_draw
+ *             scans, on every board;
+ * - connect4: the bitboard and run-time sized Connect-N wins and scores
+ *             (kept incrementally) with a scan of every window;
+ * - triples:  the 5x5 three-in-a-row counts (kept incrementally) with a
+ *             scan of every segment, as marks are placed and lifted;
+ * - solver:   the Four-in-a-Row and 5x5 solvers with a plain full-depth
+ *             search;
+ * - database: 5x5 database lookups of all eight rotations and reflections
+ *             of a position with its solved value.
+ * With no argument every check runs. Prints one line per check and exits
+ * with 1 if any position disagrees.
+ */
+
+#include "NUMTTT_classes.h"
+#include "XO_Classes.h"
+#include "FourInRow_Classes.h"
+#include "FourInRowSolver_Classes.h"
+#include "Misere_Classes.h"
+#include "FiveXFiveTTT_Classes.h"
+#include "FiveXFiveTTTSolver_Classes.h"
+#include "FiveXFiveTTTDatabase_Classes.h"
+#include "Infinity_Tic-Tac-Toe.h"
+#include "SUS_Classes.h"
+#include "Pyramid_Classes.h"
+#include "word_Tic-Tac-Toe.h"
+#include "DiamondTTT_Classes.h"
+#include "ultimateTTT_Classes.h"
+#include "Memory_Classes.h"
+#include "Obstacles_Tic-Tac-Toe.h"
+#include "FourByFour_Classes.h"
+#include "SelfPlay_Classes.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+
+using namespace std;
+
+namespace {
+
+/** @brief Seed of the first random game of every check; later games count up. */
+const unsigned CHECK_SEED = 20240601;
+
+/** @brief Positions compared and positions that disagreed, for one check. */
+struct Tally {
+    long long positions = 0;
+    long long failures = 0;
+
+    /** @brief Counts one comparison, printing the first few failures. */
+    void expect(bool ok, const string& what) {
+        positions++;
+        if (ok) return;
+        if (++failures <= 5) cerr << "  mismatch: " << what << "\n";
+    }
+};
+
+// -----------------------------------------------------------------------------
+// outcome
+// -----------------------------------------------------------------------------
+
+/** @brief The outcome as GameManager worked it out before get_outcome(). */
+template <typename T>
+Outcome scanned_outcome(Board<T>& board, Player<T>* player) {
+    if (board.is_win(player)) return Outcome::WIN;
+    if (board.is_lose(player)) return Outcome::LOSE;
+    if (board.is_draw(player)) return Outcome::DRAW;
+    return Outcome::ONGOING;
+}
+
+/**
+ * @brief Plays `games` random games on boards from `make` and compares the
+ * cached outcome with the scans after every move.
+ */
+template <typename T>
+void check_outcome(Tally& tally, const string& name, function<Board<T>*(unsigned)> make,
+                   T sym_x, T sym_o, int games) {
+    MoveList<T> moves;
+    for (int g = 0; g < games; ++g) {
+        unsigned seed = CHECK_SEED + g;
+        unique_ptr<Board<T>> board(make(seed));
+        minstd_rand rng(seed);
+        Player<T> players[2] = {Player<T>("X", sym_x, PlayerType::COMPUTER),
+                                Player<T>("O", sym_o, PlayerType::COMPUTER)};
+
+        for (int ply = 0; ply < 200; ++ply) {
+            Player<T>* mover = &players[ply % 2];
+            if (board->generate_moves(mover->get_symbol(), moves) == 0) break;
+            Move<T> m = moves[rng() % moves.size()];
+            if (!board->update_board(&m)) {
+                tally.expect(false, name + ": generated move rejected, seed " + to_string(seed));
+                break;
+            }
+            Outcome cached = board->get_outcome(mover);
+            tally.expect(cached == scanned_outcome(*board, mover),
+                         name + ": seed " + to_string(seed) + ", ply " + to_string(ply));
+            if (cached != Outcome::ONGOING) break;
+        }
+    }
+}
+
+void run_outcome(Tally& tally) {
+    ScopedSilence quiet; // Some boards report rejected moves and scores on cout
+    check_outcome<int>(tally, "Numerical", [](unsigned) { return new NumTTT_Board(); }, 1, 2, 100);
+    check_outcome<char>(tally, "3x3", [](unsigned) { return new X_O_Board(); }, 'X', 'O', 100);
+    check_outcome<char>(tally, "Four-in-a-Row", [](unsigned) { return new FourInRow_Board(); }, 'X', 'O', 100);
+    check_outcome<char>(tally, "Connect-5 8x9", [](unsigned) { return make_connect_board(8, 9, 5); }, 'X', 'O', 50);
+    check_outcome<char>(tally, "Connect-4 5x6", [](unsigned) { return make_connect_board(5, 6, 4); }, 'X', 'O', 50);
+    check_outcome<char>(tally, "5x5", [](unsigned) { return new FxFTTT_board(); }, 'X', 'O', 50);
+    check_outcome<char>(tally, "Word", [](unsigned) { return new word_xo_board(); }, 'X', 'O', 100);
+    check_outcome<char>(tally, "Misere 3x3", [](unsigned) { return new Misere_Board(); }, 'X', 'O', 100);
+    check_outcome<char>(tally, "Misere 5x5", [](unsigned) { return new Misere_Board(5, 4); }, 'X', 'O', 50);
+    check_outcome<char>(tally, "SUS", [](unsigned) {
+        SUS_Board* board = new SUS_Board();
+        board->set_player_letters('S', 'U');
+        return board;
+    }, 'S', 'U', 100);
+    check_outcome<char>(tally, "Pyramid", [](unsigned) { return new Pyramid_Board(); }, 'X', 'O', 100);
+    check_outcome<char>(tally, "Infinity", [](unsigned) { return new inf_xo_Board(); }, 'X', 'O', 100);
+    check_outcome<char>(tally, "Diamond", [](unsigned) { return new Diamond_Board(); }, 'X', 'O', 100);
+    check_outcome<char>(tally, "Ultimate", [](unsigned) { return new Ultimate_Board(); }, 'X', 'O', 50);
+    check_outcome<char>(tally, "Memory", [](unsigned) { return new Memory_Board(); }, 'X', 'O', 100);
+    check_outcome<char>(tally, "Obstacles", [](unsigned seed) { return new obstacles_TTT_board(seed); }, 'X', 'O', 100);
+    check_outcome<char>(tally, "4x4", [](unsigned) { return new FourByFour_Board(); }, 'X', 'O', 50);
+}
+
+// -----------------------------------------------------------------------------
+// connect4
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief Heuristic of `piece` on `board`, by the original rules: 3 per disc
+ * in the centre column, plus the score of every window of `connect` cells.
+ */
+int scanned_score(const Board<char>& board, int connect, char piece) {
+    int rows = board.get_rows(), columns = board.get_columns();
+    int score = 0;
+    for (int r = 0; r < rows; ++r)
+        if (board.get_cell(r, columns / 2) == piece) score += 3;
+
+    const int dirs[4][2] = {{0, 1}, {1, 0}, {1, 1}, {1, -1}};
+    for (const auto& d : dirs)
+        for (int r = 0; r < rows; ++r)
+            for (int c = 0; c < columns; ++c) {
+                int end_r = r + d[0] * (connect - 1), end_c = c + d[1] * (connect - 1);
+                if (end_r < 0 || end_r >= rows || end_c < 0 || end_c >= columns) continue;
+                int own = 0, empty = 0, opp = 0;
+                for (int k = 0; k < connect; ++k) {
+                    char cell = board.get_cell(r + d[0] * k, c + d[1] * k);
+                    if (cell == piece) own++;
+                    else if (cell == '.') empty++;
+                    else opp++;
+                }
+                if (own == connect) score += 100;
+                else if (own == connect - 1 && empty == 1) score += 5;
+                else if (own == connect - 2 && empty == 2) score += 2;
+                if (opp == connect - 1 && empty == 1) score -= 4;
+            }
+    return score;
+}
+
+/** @brief True if `piece` has `connect` in a row anywhere on `board`. */
+bool scanned_win(const Board<char>& board, int connect, char piece) {
+    int rows = board.get_rows(), columns = board.get_columns();
+    const int dirs[4][2] = {{0, 1}, {1, 0}, {1, 1}, {1, -1}};
+    for (const auto& d : dirs)
+        for (int r = 0; r < rows; ++r)
+            for (int c = 0; c < columns; ++c) {
+                int k = 0;
+                while (k < connect) {
+                    int rr = r + d[0] * k, cc = c + d[1] * k;
+                    if (rr < 0 || rr >= rows || cc < 0 || cc >= columns || board.get_cell(rr, cc) != piece) break;
+                    ++k;
+                }
+                if (k == connect) return true;
+            }
+    return false;
+}
+
+/**
+ * @brief Plays the same random games on a compiled and a run-time sized
+ * board and compares both with the scans after every move. Also checks
+ * that a search position's make and undo leave its score and key as
+ * they were.
+ */
+template <int ROWS, int COLUMNS, int CONNECT>
+void check_connect(Tally& tally, int games) {
+    typedef ConnectN_Board<ROWS, COLUMNS, CONNECT> Fast;
+    string name = "Connect-" + to_string(CONNECT) + " " + to_string(ROWS) + "x" + to_string(COLUMNS);
+    MoveList<char> moves;
+    for (int g = 0; g < games; ++g) {
+        unsigned seed = CHECK_SEED + g;
+        minstd_rand rng(seed);
+        Fast fast;
+        ConnectN_DynamicBoard dynamic(ROWS, COLUMNS, CONNECT);
+        Player<char> players[2] = {Player<char>("X", 'X', PlayerType::COMPUTER),
+                                   Player<char>("O", 'O', PlayerType::COMPUTER)};
+
+        for (int ply = 0; ply < ROWS * COLUMNS; ++ply) {
+            Player<char>* mover = &players[ply % 2];
+            fast.generate_moves(mover->get_symbol(), moves);
+            Move<char> m = moves[rng() % moves.size()];
+            Move<char> copy = m;
+            fast.update_board(&m);
+            dynamic.update_board(&copy);
+
+            string where = name + ": seed " + to_string(seed) + ", ply " + to_string(ply);
+            for (char piece : {'X', 'O'}) {
+                int expected = scanned_score(fast, CONNECT, piece);
+                tally.expect(typename Fast::Position(fast, piece).evaluate() == expected, where + ", bitboard score");
+                tally.expect(ConnectN_DynamicPosition(dynamic, piece).evaluate() == expected, where + ", dynamic score");
+            }
+            bool won = scanned_win(fast, CONNECT, mover->get_symbol());
+            tally.expect(fast.is_win(mover) == won, where + ", bitboard win");
+            tally.expect(dynamic.is_win(mover) == won, where + ", dynamic win");
+
+            // Every child of the next position, made and undone
+            char next = players[(ply + 1) % 2].get_symbol();
+            typename Fast::Position pos(fast, next);
+            int score = pos.evaluate();
+            uint64_t key = pos.key();
+            MoveList<char> children;
+            pos.generate_moves(children);
+            for (int i = 0; i < children.size(); ++i) {
+                pos.make_move(children[i]);
+                pos.undo_move(children[i]);
+            }
+            tally.expect(pos.evaluate() == score && pos.key() == key, where + ", make and undo");
+
+            if (won || ply + 1 == ROWS * COLUMNS) break;
+        }
+    }
+}
+
+void run_connect4(Tally& tally) {
+    check_connect<6, 7, 4>(tally, 200);
+    check_connect<8, 9, 5>(tally, 50);
+}
+
+// -----------------------------------------------------------------------------
+// triples
+// -----------------------------------------------------------------------------
+
+/** @brief Three-in-a-rows of `piece` on a 5x5 board, counted over all 48 segments. */
+int scanned_triples(const Board<char>& board, char piece) {
+    const int dirs[4][2] = {{0, 1}, {1, 0}, {1, 1}, {1, -1}};
+    int count = 0;
+    for (const auto& d : dirs)
+        for (int r = 0; r < 5; ++r)
+            for (int c = 0; c < 5; ++c) {
+                int end_r = r + d[0] * 2, end_c = c + d[1] * 2;
+                if (end_r < 0 || end_r >= 5 || end_c < 0 || end_c >= 5) continue;
+                int own = 0;
+                for (int k = 0; k < 3; ++k) own += board.get_cell(r + d[0] * k, c + d[1] * k) == piece;
+                if (own == 3) count++;
+            }
+    return count;
+}
+
+/**
+ * @brief Places and lifts random marks on a 5x5 board with simulate_move()
+ * and undo_move(), comparing the kept three-in-a-row counts with a scan
+ * of every segment after each step.
+ */
+void run_triples(Tally& tally) {
+    for (int g = 0; g < 300; ++g) {
+        unsigned seed = CHECK_SEED + g;
+        minstd_rand rng(seed);
+        FxFTTT_board board;
+        vector<pair<int, int>> placed;
+
+        for (int step = 0; step < 60; ++step) {
+            if (!placed.empty() && (placed.size() == 24 || rng() % 4 == 0)) {
+                board.undo_move(placed.back().first, placed.back().second);
+                placed.pop_back();
+            } else {
+                vector<pair<int, int>> empty;
+                for (int r = 0; r < 5; ++r)
+                    for (int c = 0; c < 5; ++c)
+                        if (board.get_cell(r, c) == '.') empty.push_back({r, c});
+                pair<int, int> cell = empty[rng() % empty.size()];
+                board.simulate_move(cell.first, cell.second, placed.size() % 2 == 0 ? 'X' : 'O');
+                placed.push_back(cell);
+            }
+
+            string where = "seed " + to_string(seed) + ", step " + to_string(step);
+            for (char piece : {'X', 'O'})
+                tally.expect(board.triples_of(piece) == scanned_triples(board, piece),
+                             where + ", " + piece + " triples");
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+// solver
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief Four-in-a-Row value of `pos` for the side to move, in the
+ * solver's scoring, by alpha-beta over every move.
+ */
+int connect4_negamax(FourInRow_Position& pos, int filled, int alpha, int beta) {
+    if (filled == 42) return 0;
+    MoveList<char> moves;
+    pos.generate_moves(moves);
+    for (int i = 0; i < moves.size(); ++i) {
+        pos.make_move(moves[i]);
+        int score = pos.last_move_outcome() == Outcome::WIN ? 22 - (filled + 2) / 2
+                                                            : -connect4_negamax(pos, filled + 1, -beta, -alpha);
+        pos.undo_move(moves[i]);
+        if (score > alpha) alpha = score;
+        if (alpha >= beta) break;
+    }
+    return alpha;
+}
+
+/** @brief Three-in-a-rows of the 5x5 cells in `mask` (bit r * 5 + c). */
+int count_triples(uint32_t mask) {
+    const int dirs[4][2] = {{0, 1}, {1, 0}, {1, 1}, {1, -1}};
+    int n = 0;
+    for (const auto& d : dirs)
+        for (int r = 0; r < 5; ++r)
+            for (int c = 0; c < 5; ++c) {
+                int k = 0;
+                for (; k < 3; ++k) {
+                    int rr = r + d[0] * k, cc = c + d[1] * k;
+                    if (rr < 0 || rr >= 5 || cc < 0 || cc >= 5 || !(mask >> (rr * 5 + cc) & 1)) break;
+                }
+                if (k == 3) n++;
+            }
+    return n;
+}
+
+/** @brief Final 5x5 score for the side to move, by trying every move order. */
+int fxf_negamax(uint32_t mover, uint32_t other, int played) {
+    if (played == FxFTTT_Solver::LAST_MOVE) return count_triples(mover) - count_triples(other);
+    int best = -100;
+    for (int cell = 0; cell < FxFTTT_Solver::CELLS; ++cell) {
+        uint32_t bit = 1u << cell;
+        if ((mover | other) & bit) continue;
+        best = max(best, -fxf_negamax(other, mover | bit, played + 1));
+    }
+    return best;
+}
+
+/** @brief Random 5x5 position with `plies` moves played; X, the first player, is `masks[0]`. */
+void random_fxf(minstd_rand& rng, int plies, uint32_t masks[2]) {
+    masks[0] = masks[1] = 0;
+    for (int k = 0; k < plies; ++k) {
+        int cell;
+        do cell = rng() % FxFTTT_Solver::CELLS;
+        while (((masks[0] | masks[1]) >> cell) & 1);
+        masks[k % 2] |= 1u << cell;
+    }
+}
+
+void run_solver(Tally& tally) {
+    ScopedSilence quiet;
+    FourInRow_Solver connect4(20);
+    MoveList<char> moves;
+    for (int g = 0; g < 200; ++g) {
+        unsigned seed = CHECK_SEED + g;
+        minstd_rand rng(seed);
+        Player<char> players[2] = {Player<char>("X", 'X', PlayerType::COMPUTER),
+                                   Player<char>("O", 'O', PlayerType::COMPUTER)};
+
+        // A random game to 30 discs, started again if someone wins first
+        unique_ptr<FourInRow_Board> board(new FourInRow_Board());
+        while (board->get_n_moves() < 30) {
+            Player<char>* mover = &players[board->get_n_moves() % 2];
+            board->generate_moves(mover->get_symbol(), moves);
+            Move<char> m = moves[rng() % moves.size()];
+            board->update_board(&m);
+            if (board->get_outcome(mover) != Outcome::ONGOING) board.reset(new FourInRow_Board());
+        }
+        char side = players[board->get_n_moves() % 2].get_symbol();
+        FourInRow_Position pos(*board, side);
+        int expected = connect4_negamax(pos, board->get_n_moves(), -100, 100);
+        FourInRow_Solution solution = connect4.solve(*board, side);
+        tally.expect(solution.score == expected,
+                     "Four-in-a-Row: seed " + to_string(seed) + ", solver " + to_string(solution.score) +
+                     ", search " + to_string(expected));
+    }
+
+    FxFTTT_Solver fxf(16);
+    minstd_rand rng(CHECK_SEED);
+    for (int g = 0; g < 300; ++g) {
+        uint32_t masks[2];
+        int plies = 17 + g % 3; // Up to 7 moves left
+        random_fxf(rng, plies, masks);
+        uint32_t mover = masks[plies % 2], other = masks[1 - plies % 2];
+        int expected = fxf_negamax(mover, other, plies);
+        tally.expect(fxf.solve(mover, other) == expected, "5x5: position " + to_string(g));
+    }
+}
+
+// -----------------------------------------------------------------------------
+// database
+// -----------------------------------------------------------------------------
+
+/** @brief `mask` moved by symmetry `t`. */
+uint32_t transform_mask(int t, uint32_t mask) {
+    uint32_t image = 0;
+    for (int cell = 0; cell < FxFTTT_Solver::CELLS; ++cell)
+        if ((mask >> cell) & 1) image |= 1u << FxFTTT_Solver::transform_cell(t, cell);
+    return image;
+}
+
+void run_database(Tally& tally) {
+    FxFTTT_Solver solver(16);
+    minstd_rand rng(CHECK_SEED);
+
+    // Solved positions 14 to 17 moves in, entries packed as in the file
+    vector<pair<uint32_t, uint32_t>> positions;
+    vector<uint64_t> entries;
+    for (int g = 0; g < 300; ++g) {
+        uint32_t masks[2];
+        int plies = 14 + g % 4;
+        random_fxf(rng, plies, masks);
+        uint32_t mover = masks[plies % 2], other = masks[1 - plies % 2];
+        int score;
+        int cell = solver.best_cell(mover, other, &score);
+        int symmetry;
+        uint64_t key = FxFTTT_Solver::canonical(mover, other, &symmetry);
+        positions.push_back({mover, other});
+        entries.push_back(key << 14 | uint64_t(score + 64) << 5 | uint64_t(FxFTTT_Solver::transform_cell(symmetry, cell)));
+    }
+    sort(entries.begin(), entries.end());
+    entries.erase(unique(entries.begin(), entries.end(), [](uint64_t a, uint64_t b) { return a >> 14 == b >> 14; }),
+                  entries.end());
+
+    string path = (filesystem::temp_directory_path() / ("checks_fxfttt_" + to_string(CHECK_SEED) + ".bin")).string();
+    FxFTTT_Database database;
+    bool opened = FxFTTT_Database::write(path, entries, 17) && database.open(path);
+    tally.expect(opened, "database: cannot write or open " + path);
+    if (!opened) return;
+
+    for (size_t i = 0; i < positions.size(); ++i) {
+        int value = solver.solve(positions[i].first, positions[i].second);
+        for (int t = 0; t < 8; ++t) {
+            uint32_t mover = transform_mask(t, positions[i].first);
+            uint32_t other = transform_mask(t, positions[i].second);
+            string where = "database: position " + to_string(i) + ", symmetry " + to_string(t);
+            int cell = -1, score = 0;
+            if (!database.lookup(mover, other, cell, &score)) {
+                tally.expect(false, where + ", not found");
+                continue;
+            }
+            uint32_t bit = 1u << cell;
+            bool empty = cell >= 0 && cell < FxFTTT_Solver::CELLS && !((mover | other) & bit);
+            tally.expect(score == value && empty && -solver.solve(other, mover | bit) == value, where);
+        }
+    }
+    database.close();
+    remove(path.c_str());
+}
+
+} // namespace
+
+/**
+ * @brief Runs the checks named on the command line, or all of them.
+ * @return 0 if every position agreed, 1 otherwise or on bad arguments.
+ */
+int main(int argc, char* argv[]) {
+    const pair<const char*, void (*)(Tally&)> checks[] = {
+        {"outcome", run_outcome},
+        {"connect4", run_connect4},
+        {"triples", run_triples},
+        {"solver", run_solver},
+        {"database", run_database},
+    };
+
+    vector<const char*> names;
+    for (int i = 1; i < argc; ++i) names.push_back(argv[i]);
+    if (names.empty())
+        for (const auto& check : checks) names.push_back(check.first);
+
+    bool ok = true;
+    for (const char* name : names) {
+        auto it = find_if(begin(checks), end(checks), [name](const auto& c) { return strcmp(c.first, name) == 0; });
+        if (it == end(checks)) {
+            cerr << "Usage: checks [outcome|connect4|triples|solver|database ...]\n";
+            return 1;
+        }
+        Tally tally;
+        it->second(tally);
+        cout << name << ": " << tally.positions << " comparisons, " << tally.failures << " mismatches\n";
+        ok = ok && tally.failures == 0;
+    }
+    return ok ? 0 : 1;
+}
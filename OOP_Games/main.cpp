@@ -10,7 +10,7 @@
 #include <cstdlib>
 #include <ctime>
 #include "BoardGame_Classes.h"
-#include "NumTTT_Classes.h"
+#include "NUMTTT_classes.h"
 #include "XO_Classes.h"
 #include "FourInRow_Classes.h"
 #include "Misere_Classes.h"
@@ -24,6 +24,9 @@
 #include "Memory_Classes.h"
 #include "Obstacles_Tic-Tac-Toe.h"
 #include "FourByFour_Classes.h"
+#include "SelfPlay_Classes.h"
+#include <chrono>
+#include <cstring>
 
 using namespace std;
 
@@ -61,11 +64,11 @@ void run_XO() {
 }
 
 /**
- * @brief Runs the Four-in-a-Row game.
+ * @brief Runs the Four-in-a-Row game, on a board shape chosen by the user.
  */
 void run_FourInRow() {
     srand(static_cast<unsigned int>(time(0)));
-    FourInRow_Board *four_board = new FourInRow_Board();
+    ConnectN_BoardBase *four_board = FourInRow_UI::choose_board();
     FourInRow_UI *four_ui = new FourInRow_UI(four_board);
     Player<char> **players = four_ui->setup_players();
     GameManager<char> four_game(four_board, players, four_ui);
@@ -109,11 +112,11 @@ void run_word_ttt() {
 }
 
 /**
- * @brief Runs Misere Tic-Tac-Toe (Loser wins).
+ * @brief Runs Misere Tic-Tac-Toe (Loser wins), on a board size chosen by the user.
  */
 void run_Misere() {
     srand(static_cast<unsigned int>(time(0)));
-    Misere_Board *board = new Misere_Board();
+    Misere_Board *board = Misere_UI::choose_board();
     Misere_UI *ui = new Misere_UI(board);
     Player<char> **players = ui->setup_players();
     GameManager<char> gm(board, players, ui);
@@ -254,11 +257,56 @@ void run_Memory() {
     delete[] players;
 }
 
+/**
+ * @brief Plays computer-vs-computer games headless and prints a summary.
+ * @param game Game number as in the main menu (1-14).
+ * @param n_games Number of games to play.
+ * @return 0 on success, 1 on an invalid game number.
+ */
+int run_self_play(int game, int n_games) {
+    const vector<SelfPlayGame>& games = self_play_games();
+    if (game < 1 || game > (int)games.size()) {
+        cout << "Invalid game. Please select [1-" << games.size() << "].\n";
+        return 1;
+    }
+    const SelfPlayGame& entry = games[game - 1];
+
+    int wins[2] = {0, 0}, draws = 0;
+    long long moves = 0, think_ns = 0;
+    auto start = chrono::steady_clock::now();
+    {
+        ScopedSilence quiet;
+        for (int i = 0; i < n_games; ++i) {
+            SelfPlayResult r = entry.play(0, 0, (unsigned)i + 1, nullptr);
+            if (r.winner == -1) draws++;
+            else wins[r.winner]++;
+            moves += r.n_moves;
+            think_ns += r.think_ns[0] + r.think_ns[1];
+        }
+    }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    cout << entry.name << ": " << n_games << " games in " << seconds << " s ("
+         << (seconds > 0 ? n_games / seconds : 0) << " games/s)\n";
+    cout << "First player wins: " << wins[0] << ", second player wins: " << wins[1]
+         << ", draws: " << draws << "\n";
+    cout << "Mean move time: " << (moves ? think_ns / moves : 0) << " ns over " << moves << " moves\n";
+    return 0;
+}
+
 /**
  * @brief Main function. Displays the menu and processes user input.
+ *
+ * `OOP_Games --selfplay <game> [games]` plays computer-vs-computer games
+ * headless instead of showing the menu.
  * @return 0 upon successful execution.
  */
-int main() {
+int main(int argc, char* argv[]) {
+    if (argc >= 3 && strcmp(argv[1], "--selfplay") == 0) {
+        int n_games = (argc >= 4) ? atoi(argv[3]) : 1000;
+        return run_self_play(atoi(argv[2]), n_games);
+    }
+
     int choice;
 
     while (true) {
@@ -271,7 +319,7 @@ int main() {
         cout << "3. Four-in-a-Row\n";
         cout << "4. 5*5 Tic-Tac-Toe\n";
         cout << "5. word Tic-Tac-Toe\n";
-        cout << "6. Misere Tic-Tac-Toe(3x3)\n";
+        cout << "6. Misere Tic-Tac-Toe(NxN)\n";
         cout << "7. SUS\n";
         cout << "8. Pyramid Tic-Tac-Toe\n";
         cout << "9. Infinite Tic-Tac-Toe\n";
@@ -0,0 +1,48 @@
+/**
+ * @file tournament.cpp
+ * @brief Command-line runner for parallel computer-vs-computer tournaments.
+ *
+ * Usage: tournament [-n games_per_pairing] [-j threads] [-s seed] [game ...]
+ *
+ * Games are numbered as in the main menu (1-14); with none given, all
+ * games are played.
+ */
+
+#include "Tournament_Classes.h"
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+using namespace std;
+
+/**
+ * @brief Parses the options, runs the tournament and prints the table.
+ * @return 0 on success, 1 on bad arguments.
+ */
+int main(int argc, char* argv[]) {
+    TournamentOptions options;
+    int n_games = (int)self_play_games().size();
+
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            options.games_per_pairing = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-j") == 0 && i + 1 < argc) {
+            options.threads = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) {
+            options.seed = (unsigned)strtoul(argv[++i], nullptr, 10);
+        } else {
+            int game = atoi(argv[i]);
+            if (game < 1 || game > n_games) {
+                cerr << "Usage: tournament [-n games_per_pairing] [-j threads] [-s seed] [game 1-"
+                     << n_games << " ...]\n";
+                return 1;
+            }
+            options.games.push_back(game - 1);
+        }
+    }
+
+    Tournament tournament(options);
+    tournament.run();
+    tournament.print(cout);
+    return 0;
+}
@@ -18,9 +18,10 @@ const char Ultimate_Board::blank_symbol = ' ';
 Ultimate_Board::Ultimate_Board() : Board<char>(9,9) {
     for (int r = 0; r < rows; ++r)
         for (int c = 0; c < columns; ++c)
-            board[r][c] = blank_symbol;
+            set_cell(r, c, blank_symbol);
     main_claims.assign(9, ' ');
     forced_main = -1;
+    toggle_state_key(0, forced_main);
     n_moves = 0;
 }
 
@@ -34,13 +35,14 @@ bool Ultimate_Board::update_board(Move<char>* move) {
     if (main_claims[main_idx] != ' ') return false;
 
     int gr, gc; unpack_indices(main_idx, sub_idx, gr, gc);
-    if (board[gr][gc] != blank_symbol) return false;
+    if (cell(gr, gc) != blank_symbol) return false;
 
     // Check constraints
     if (forced_main != -1 && forced_main != main_idx) return false;
 
-    board[gr][gc] = sym;
+    set_cell(gr, gc, sym);
     ++n_moves;
+    record_move(gr, gc);
 
     // Check if this move won the sub-board
     char winner = check_subboard_winner(main_idx);
@@ -48,51 +50,51 @@ bool Ultimate_Board::update_board(Move<char>* move) {
     else if (subboard_full(main_idx) && main_claims[main_idx] == ' ') main_claims[main_idx] = 'D';
 
 
-    forced_main = -1;
+    set_forced_main(-1);
 
     return true;
 }
 
+void Ultimate_Board::set_forced_main(int main_idx) {
+    toggle_state_key(0, forced_main);
+    forced_main = main_idx;
+    toggle_state_key(0, forced_main);
+}
+
 bool Ultimate_Board::valid_subcell(int main_idx, int sub_idx) const {
     if (main_idx < 0 || main_idx >= 9 || sub_idx < 0 || sub_idx >= 9) return false;
     if (main_claims[main_idx] != ' ') return false;
     int gr, gc; unpack_indices(main_idx, sub_idx, gr, gc);
-    if (board[gr][gc] != blank_symbol) return false;
+    if (cell(gr, gc) != blank_symbol) return false;
     if (forced_main != -1 && forced_main != main_idx) return false;
     return true;
 }
 
-vector<pair<int,int>> Ultimate_Board::get_all_empty_in_main(int main_idx) const {
-    vector<pair<int,int>> res;
-    if (main_idx < 0 || main_idx >= 9) return res;
-    if (main_claims[main_idx] != ' ') return res;
-    for (int sr = 0; sr < 3; ++sr)
-        for (int sc = 0; sc < 3; ++sc) {
-            int sub_idx = sr*3 + sc;
-            int gr, gc; unpack_indices(main_idx, sub_idx, gr, gc);
-            if (board[gr][gc] == blank_symbol) res.emplace_back(main_idx, sub_idx);
-        }
-    return res;
+int Ultimate_Board::add_empty_in_main(int main_idx, char symbol, MoveList<char>& moves) const {
+    if (main_idx < 0 || main_idx >= 9) return 0;
+    if (main_claims[main_idx] != ' ') return 0;
+    int added = 0;
+    for (int sub_idx = 0; sub_idx < 9; ++sub_idx) {
+        int gr, gc; unpack_indices(main_idx, sub_idx, gr, gc);
+        if (cell(gr, gc) == blank_symbol) { moves.add(main_idx, sub_idx, symbol); ++added; }
+    }
+    return added;
 }
 
-vector<pair<int,int>> Ultimate_Board::get_allowed_moves() const {
-    vector<pair<int,int>> moves;
+int Ultimate_Board::generate_moves(char symbol, MoveList<char>& moves) const {
+    moves.clear();
     if (forced_main != -1 && main_claims[forced_main] == ' ') {
-        return get_all_empty_in_main(forced_main);
+        return add_empty_in_main(forced_main, symbol, moves);
     }
-    for (int m = 0; m < 9; ++m) {
-        if (main_claims[m] != ' ') continue;
-        auto v = get_all_empty_in_main(m);
-        moves.insert(moves.end(), v.begin(), v.end());
-    }
-    return moves;
+    for (int m = 0; m < 9; ++m) add_empty_in_main(m, symbol, moves);
+    return moves.size();
 }
 
 char Ultimate_Board::check_subboard_winner(int main_idx) const {
     int mr = main_idx / 3, mc = main_idx % 3;
     auto get = [&](int sr, int sc)->char {
         int gr = mr*3 + sr, gc = mc*3 + sc;
-        return board[gr][gc];
+        return cell(gr, gc);
     };
     // Standard TTT check
     for (int r = 0; r < 3; ++r) {
@@ -112,7 +114,7 @@ bool Ultimate_Board::subboard_full(int main_idx) const {
     int mr = main_idx / 3, mc = main_idx % 3;
     for (int sr = 0; sr < 3; ++sr)
         for (int sc = 0; sc < 3; ++sc)
-            if (board[mr*3 + sr][mc*3 + sc] == blank_symbol) return false;
+            if (cell(mr*3 + sr, mc*3 + sc) == blank_symbol) return false;
     return true;
 }
 
@@ -147,6 +149,27 @@ bool Ultimate_Board::game_is_over(Player<char>* player) {
     return is_win(player) || is_draw(player);
 }
 
+Outcome Ultimate_Board::evaluate_last_move(Player<char>* player) {
+    char sym = player->get_symbol();
+    int main_idx = (last_x / 3) * 3 + last_y / 3;
+
+    // Only the sub-board just played in can have been decided by this move
+    if (main_claims[main_idx] == ' ') return Outcome::ONGOING;
+
+    if (main_claims[main_idx] == sym) {
+        int mr = main_idx / 3, mc = main_idx % 3;
+        auto owns = [&](int a, int b, int c) {
+            return main_claims[a] == sym && main_claims[b] == sym && main_claims[c] == sym;
+        };
+        if (owns(mr * 3, mr * 3 + 1, mr * 3 + 2) || owns(mc, 3 + mc, 6 + mc) ||
+            (mr == mc && owns(0, 4, 8)) || (mr + mc == 2 && owns(2, 4, 6)))
+            return Outcome::WIN;
+    }
+
+    for (char c : main_claims) if (c == ' ') return Outcome::ONGOING;
+    return Outcome::DRAW;
+}
+
 // ... (Rest of AI and UI functions follow structure)
 
 Ultimate_AIPlayer::Ultimate_AIPlayer(const string& name, char symbol)
@@ -154,30 +177,28 @@ Ultimate_AIPlayer::Ultimate_AIPlayer(const string& name, char symbol)
     srand((unsigned)time(nullptr));
 }
 
-pair<int,int> Ultimate_AIPlayer::pick_random(const vector<pair<int,int>>& v) const {
-    if (v.empty()) return {-1,-1};
-    int idx = rand() % v.size();
-    return v[idx];
+pair<int,int> Ultimate_AIPlayer::pick_random(const MoveList<char>& moves) const {
+    if (moves.empty()) return {-1,-1};
+    const Move<char>& m = moves[rand() % moves.size()];
+    return {m.get_x(), m.get_y()};
 }
 
-Move<char>* Ultimate_AIPlayer::get_simple_move(Ultimate_Board* board) {
-    auto allowed = board->get_allowed_moves();
-    if (allowed.empty()) { // Fallback if stuck
-        for (int m = 0; m < 9; ++m) {
-            auto v = board->get_all_empty_in_main(m);
-            if (!v.empty()) { allowed = v; break; }
-        }
+Move<char> Ultimate_AIPlayer::get_simple_move(Ultimate_Board* board) {
+    MoveList<char> allowed;
+    if (board->generate_moves(get_symbol(), allowed) == 0) { // Fallback if stuck
+        for (int m = 0; m < 9; ++m)
+            if (board->add_empty_in_main(m, get_symbol(), allowed) > 0) break;
     }
     auto pick = pick_random(allowed);
-    if (pick.first == -1) return new Move<char>(0,0,get_symbol());
-    return new Move<char>(pick.first, pick.second, get_symbol());
+    if (pick.first == -1) return Move<char>(0,0,get_symbol());
+    return Move<char>(pick.first, pick.second, get_symbol());
 }
 
 Ultimate_UI::Ultimate_UI(Ultimate_Board* board) : UI<char>("Ultimate Tic-Tac-Toe", 1), board_ptr(board) {
     srand((unsigned)time(nullptr));
 }
 
-void Ultimate_UI::display_board_matrix(const vector<vector<char>>& matrix) const {}
+void Ultimate_UI::display_board_matrix(const BoardView<char>&) const {}
 
 Player<char>** Ultimate_UI::setup_players() {
     Player<char>** players = new Player<char>*[2];
@@ -253,9 +274,9 @@ Move<char>* Ultimate_UI::get_move(Player<char>* player) {
         cin >> mr >> mc >> sr >> sc;
         int main_idx = mr*3 + mc;
         int sub_idx = sr*3 + sc;
-        return new Move<char>(main_idx, sub_idx, player->get_symbol());
+        return move_slot.emplace(main_idx, sub_idx, player->get_symbol());
     } else {
         Ultimate_AIPlayer* ai = dynamic_cast<Ultimate_AIPlayer*>(player);
-        return ai->get_simple_move(board_ptr);
+        return move_slot.store(ai->get_simple_move(board_ptr));
     }
 }
\ No newline at end of file
@@ -62,19 +62,25 @@ public:
     virtual bool game_is_over(Player<char>* player) override;
 
     /**
-     * @brief Validates if a move is within bounds of a sub-board.
+     * @brief Win if the sub-board just claimed completes a main line, draw when all are decided.
      */
-    bool valid_subcell(int main_idx, int sub_idx) const;
+    Outcome evaluate_last_move(Player<char>* player) override;
+
+    /**
+     * @brief Every empty cell of an undecided sub-board, as (main index, sub index).
+     */
+    int generate_moves(char symbol, MoveList<char>& moves) const override;
 
     /**
-     * @brief Gets all allowed moves based on current state and forced board.
+     * @brief Validates if a move is within bounds of a sub-board.
      */
-    vector<pair<int,int>> get_allowed_moves() const;
+    bool valid_subcell(int main_idx, int sub_idx) const;
 
     /**
-     * @brief Gets empty cells in a specific sub-board.
+     * @brief Appends the empty cells of one undecided sub-board to `moves`.
+     * @return Number of cells added.
      */
-    vector<pair<int,int>> get_all_empty_in_main(int main_idx) const;
+    int add_empty_in_main(int main_idx, char symbol, MoveList<char>& moves) const;
 
     // ... (helper functions for AI simulation omitted for brevity but should be documented similarly)
     bool make_temp_move(int main_idx, int sub_idx, char symbol);
@@ -89,6 +95,11 @@ private:
     vector<char> main_claims; ///< Status of the 9 main sub-boards.
     int forced_main;          ///< Index of sub-board next player MUST play in.
 
+    /**
+     * @brief Changes forced_main, keeping the board hash in step.
+     */
+    void set_forced_main(int main_idx);
+
     char check_subboard_winner(int main_idx) const;
     bool subboard_full(int main_idx) const;
     char check_three_in_row_on_main(char who) const;
@@ -116,12 +127,12 @@ public:
     /**
      * @brief Selects a move for the AI.
      * @param board Pointer to the Ultimate_Board.
-     * @return Pointer to selected Move.
+     * @return Selected Move.
      */
-    Move<char>* get_simple_move(Ultimate_Board* board);
+    Move<char> get_simple_move(Ultimate_Board* board);
 
 private:
-    pair<int,int> pick_random(const vector<pair<int,int>>& v) const;
+    pair<int,int> pick_random(const MoveList<char>& moves) const;
 };
 
 /**
@@ -141,7 +152,7 @@ public:
     /**
      * @brief Displays the board state.
      */
-    virtual void display_board_matrix(const vector<vector<char>>& matrix) const override;
+    virtual void display_board_matrix(const BoardView<char>& view) const override;
 
     void print_main_board_only() const;
     void print_full_board() const;
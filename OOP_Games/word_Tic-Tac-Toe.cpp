@@ -12,13 +12,8 @@
 
 using namespace std;
 
-word_xo_board::word_xo_board() : Board(3, 3) {
-    for (auto& row : board) {
-        for (auto& cell : row) {
-            cell = blank_symbol;
-        }
-    }
-    load_dictionary();
+word_xo_board::word_xo_board() : Board(3, 3), dictionary(load_dictionary()) {
+    fill_cells(blank_symbol);
 }
 
 bool word_xo_board::update_board(Move<char> *move) {
@@ -27,19 +22,26 @@ bool word_xo_board::update_board(Move<char> *move) {
     char symbol = move->get_symbol();
 
     if (x < 0 || x > rows-1 || y < 0 || y > columns-1) return false;
-    if (board[x][y] != blank_symbol) return false;
+    if (cell(x, y) != blank_symbol) return false;
 
-    board[x][y] = symbol;
+    set_cell(x, y, symbol);
+    n_moves++;
+    record_move(x, y);
     return true;
 }
 
-void word_xo_board::load_dictionary() {
-    ifstream file("dic.txt");
-    string word;
-    while (file >> word) {
-        dictionary.insert(word);
-    }
-    file.close();
+const unordered_set<string>& word_xo_board::load_dictionary() {
+    // Read once and shared by every board (thread-safe static initialisation)
+    static const unordered_set<string> words = [] {
+        unordered_set<string> loaded;
+        ifstream file("dic.txt");
+        string word;
+        while (file >> word) {
+            loaded.insert(word);
+        }
+        return loaded;
+    }();
+    return words;
 }
 
 bool word_xo_board::is_valid_word() {
@@ -52,8 +54,8 @@ bool word_xo_board::is_valid_word() {
     // Checking rows
     for (int i = 0 ; i < rows ; i++ ) {
         for (int j = 0 ; j + 2 < columns ; j++ ) {
-            if (not_blank(board[i][j], board[i][j+1], board[i][j + 2]) ) {
-                ww[0] = board[i][j]; ww[1] = board[i][j+1]; ww[2] = board[i][j+2]; ww[3] = '\0';
+            if (not_blank(cell(i, j), cell(i, j+1), cell(i, j + 2)) ) {
+                ww[0] = cell(i, j); ww[1] = cell(i, j+1); ww[2] = cell(i, j+2); ww[3] = '\0';
                 if (dictionary.count(ww) > 0) return true;
             }
         }
@@ -62,21 +64,21 @@ bool word_xo_board::is_valid_word() {
     // Checking columns
     for (int j = 0 ; j < columns ; j++) {
         for (int i = 0 ; i + 2 < rows ; i++ ) {
-            if (not_blank(board[i][j], board[i+1][j], board[i+2][j]) ) {
-                ww[0] = board[i][j]; ww[1] = board[i+1][j]; ww[2] = board[i+2][j]; ww[3] = '\0';
+            if (not_blank(cell(i, j), cell(i+1, j), cell(i+2, j)) ) {
+                ww[0] = cell(i, j); ww[1] = cell(i+1, j); ww[2] = cell(i+2, j); ww[3] = '\0';
                 if (dictionary.count(ww) > 0) return true;
             }
         }
     }
     // Check diagonal
-    if (not_blank(board[0][0], board[1][1], board[2][2]) ) {
-        ww[0] = board[0][0]; ww[1] = board[1][1]; ww[2] = board[2][2]; ww[3] = '\0';
+    if (not_blank(cell(0, 0), cell(1, 1), cell(2, 2)) ) {
+        ww[0] = cell(0, 0); ww[1] = cell(1, 1); ww[2] = cell(2, 2); ww[3] = '\0';
         if (dictionary.count(ww) > 0) return true;
     }
 
     // Check anti_diagonal
-    if (not_blank(board[0][2], board[1][1], board[2][0]) ) {
-        ww[0] = board[0][2]; ww[1] = board[1][1]; ww[2] = board[2][0]; ww[3] = '\0';
+    if (not_blank(cell(0, 2), cell(1, 1), cell(2, 0)) ) {
+        ww[0] = cell(0, 2); ww[1] = cell(1, 1); ww[2] = cell(2, 0); ww[3] = '\0';
         if (dictionary.count(ww) > 0) return true;
     }
     return false;
@@ -89,10 +91,8 @@ bool word_xo_board::is_win(Player<char> *player) {
 bool word_xo_board::is_lose(Player<char> *player) { return false; }
 
 bool word_xo_board::is_draw(Player<char> *player) {
-    for (auto& row : board) {
-        for (auto& cell : row) {
-            if (cell == blank_symbol) return false;
-        }
+    for (char c : board) {
+        if (c == blank_symbol) return false;
     }
     return !is_valid_word();
 }
@@ -101,22 +101,50 @@ bool word_xo_board::game_is_over(Player<char> *player) {
     return is_win(player) || is_draw(player);
 }
 
+int word_xo_board::generate_moves(char, MoveList<char> &moves) const {
+    moves.clear();
+    for (int i = 0; i < rows; ++i)
+        for (int j = 0; j < columns; ++j)
+            if (cell(i, j) == blank_symbol)
+                for (char letter = 'A'; letter <= 'Z'; ++letter) moves.add(i, j, letter);
+    return moves.size();
+}
+
+Outcome word_xo_board::evaluate_last_move(Player<char> *) {
+    // Word spelled by the full line starting at (r, c) in direction (dr, dc)
+    auto is_word = [&](int r, int c, int dr, int dc) {
+        char ww[4] = { cell(r, c), cell(r + dr, c + dc), cell(r + 2 * dr, c + 2 * dc), '\0' };
+        if (ww[0] == blank_symbol || ww[1] == blank_symbol || ww[2] == blank_symbol) return false;
+        return dictionary.count(ww) > 0;
+    };
+
+    // A new word has to use the letter just placed
+    int r = last_x, c = last_y;
+    if (is_word(r, 0, 0, 1) || is_word(0, c, 1, 0) ||
+        (r == c && is_word(0, 0, 1, 1)) || (r + c == 2 && is_word(0, 2, 1, -1)))
+        return Outcome::WIN;
+    if (n_moves == rows * columns) return Outcome::DRAW;
+    return Outcome::ONGOING;
+}
+
 void word_xo_board::simulate_move(int row, int col, char letter) {
-    board[row][col] = letter;
+    set_cell(row, col, letter);
     n_moves++;
 }
 
 void word_xo_board::undo_move(int row, int col, char) {
-    board[row][col] = blank_symbol;
+    set_cell(row, col, blank_symbol);
     n_moves--;
 }
 
-Move<char>* word_xo_board::find_best_move() {
-    vector<Move<char>*> safe_moves;
+Move<char> word_xo_board::find_best_move() {
+    // First move that does not hand the opponent a word; kept as the answer
+    // unless an immediate win turns up further on.
+    Move<char> safe_move(-1, -1, blank_symbol);
 
     for (int i = 0; i < rows; ++i) {
         for (int j = 0; j < columns; ++j) {
-            if (board[i][j] == blank_symbol) {
+            if (cell(i, j) == blank_symbol) {
                 // Try every letter 'A'-'Z'
                 for (char letter = 'A'; letter <= 'Z'; ++letter) {
 
@@ -124,41 +152,41 @@ Move<char>* word_xo_board::find_best_move() {
                     simulate_move(i, j, letter);
                     if (is_valid_word()) {
                         undo_move(i, j, letter);
-                        return new Move<char>(i, j, letter);
+                        return Move<char>(i, j, letter);
                     }
 
                     // 2. Does this move let Human win next turn?
-                    bool human_can_win = false;
-                    for (int hi = 0; hi < rows; ++hi) {
-                        for (int hj = 0; hj < columns; ++hj) {
-                            if (board[hi][hj] == blank_symbol) {
-                                for (char hletter = 'A'; hletter <= 'Z'; ++hletter) {
-                                    simulate_move(hi, hj, hletter);
-                                    if (is_valid_word()) human_can_win = true;
-                                    undo_move(hi, hj, hletter);
+                    //    Only needed until the first safe move is known.
+                    if (safe_move.get_x() == -1) {
+                        bool human_can_win = false;
+                        for (int hi = 0; hi < rows && !human_can_win; ++hi) {
+                            for (int hj = 0; hj < columns && !human_can_win; ++hj) {
+                                if (cell(hi, hj) == blank_symbol) {
+                                    for (char hletter = 'A'; hletter <= 'Z' && !human_can_win; ++hletter) {
+                                        simulate_move(hi, hj, hletter);
+                                        if (is_valid_word()) human_can_win = true;
+                                        undo_move(hi, hj, hletter);
+                                    }
                                 }
                             }
                         }
+                        if (!human_can_win) safe_move = Move<char>(i, j, letter);
                     }
                     undo_move(i, j, letter);
-
-                    if (!human_can_win) {
-                        safe_moves.push_back(new Move<char>(i, j, letter));
-                    }
                 }
             }
         }
     }
 
-    if (!safe_moves.empty()) return safe_moves[0];
+    if (safe_move.get_x() != -1) return safe_move;
 
     // Fallback
     for (int i = 0; i < rows; ++i)
         for (int j = 0; j < columns; ++j)
-            if (board[i][j] == blank_symbol)
-                return new Move<char>(i, j, 'A');
+            if (cell(i, j) == blank_symbol)
+                return Move<char>(i, j, 'A');
 
-    return nullptr;
+    return Move<char>(-1, -1, blank_symbol);
 }
 
 word_xo_ui::word_xo_ui(word_xo_board*b) : UI<char>("welcome to word tic tac toe" , 3) , board(b) {}
@@ -173,14 +201,13 @@ Move<char>* word_xo_ui::get_move(Player<char>* player) {
     if (player->get_type() != PlayerType::HUMAN) {
         int x, y;
         char letter;
-        Move<char>* best_move = board->find_best_move();
-        if (best_move) {
-            x = best_move->get_x();
-            y = best_move->get_y();
-            letter = best_move->get_symbol();
-            delete best_move;
+        Move<char> best_move = board->find_best_move();
+        if (best_move.get_x() != -1) {
+            x = best_move.get_x();
+            y = best_move.get_y();
+            letter = best_move.get_symbol();
             cout << player->get_name() << " (COMPUTER) chooses letter " << letter << " at (" << x << "," << y << ")\n";
-            return new Move<char>(x, y, letter);
+            return move_slot.store(best_move);
         }
     }
 
@@ -194,5 +221,5 @@ Move<char>* word_xo_ui::get_move(Player<char>* player) {
          cout<<"enter move . ex:{0 0 or 0 1} : "; cin>>x>>y;
 
      }while (x > 2 || x < 0 || y > 2 || y < 0);
-    return new Move<char>(x, y, letter);
+    return move_slot.emplace(x, y, letter);
 }
\ No newline at end of file
@@ -20,7 +20,7 @@ using namespace std;
  */
 class word_xo_board : public Board<char> {
 private:
-  unordered_set<string> dictionary; ///< Stores valid words loaded from `dic.txt`.
+  const unordered_set<string>& dictionary; ///< Valid words loaded from `dic.txt` (shared).
   char blank_symbol = '.';
 
 public:
@@ -59,6 +59,16 @@ public:
    */
   bool game_is_over(Player<char>* player) override;
 
+  /**
+   * @brief Win if a word runs through the last letter, draw when the board is full.
+   */
+  Outcome evaluate_last_move(Player<char>* player) override;
+
+  /**
+   * @brief Every empty cell with every letter A-Z (`symbol` is ignored).
+   */
+  int generate_moves(char symbol, MoveList<char>& moves) const override;
+
   /**
    * @brief Checks if any line on the board forms a valid word.
    * @return true if word found.
@@ -66,9 +76,10 @@ public:
   bool is_valid_word();
 
   /**
-   * @brief Loads `dic.txt` into the set.
+   * @brief Loads `dic.txt` on first use.
+   * @return The word set shared by all boards.
    */
-  void load_dictionary();
+  static const unordered_set<string>& load_dictionary();
 
   // Helpers for AI simulation
   void simulate_move(int row , int col , char symbol);
@@ -77,9 +88,9 @@ public:
   /**
    * @brief Finds the best move for AI.
    * Tries to find a winning move, or block an opponent's winning move.
-   * @return Pointer to best Move.
+   * @return Best Move, or one at (-1, -1) if the board is full.
    */
-  Move<char>* find_best_move();
+  Move<char> find_best_move();
 };
 
 /**